@@ -0,0 +1,130 @@
+#include "include/bench_runner.hpp"
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <utility>
+
+#ifndef KCUCKOUNTER_BUILD_TYPE
+#define KCUCKOUNTER_BUILD_TYPE "unknown"
+#endif
+
+namespace {
+constexpr int kFormatVersion = 1;
+constexpr qint64 kMaxBatch = qint64 { 1 } << 32;
+
+double rounded_ns(double value) { return std::round(value * 1000.0) / 1000.0; }
+} // namespace
+
+bench_runner::bench_runner(QString filter, int samples, qint64 sample_ms)
+    : filter(std::move(filter))
+    , samples(std::max(1, samples))
+    , sample_ns(std::max<qint64>(1, sample_ms) * 1000000)
+    , cases()
+    , finished()
+    , sink(0) { }
+
+void bench_runner::add(const QString& name, bench_fn fn) {
+    cases.push_back({ name, std::move(fn) });
+}
+
+QStringList bench_runner::names() const {
+    QStringList list;
+    for (const bench_case& entry : cases) {
+        list.append(entry.name);
+    }
+    return list;
+}
+
+void bench_runner::run_all() {
+    finished.clear();
+    for (const bench_case& entry : cases) {
+        if (!filter.isEmpty() && !entry.name.contains(filter)) {
+            continue;
+        }
+        const bench_result result = run_case(entry);
+        std::fprintf(
+            stderr, "%-40s %12.1f ns/op (min %.1f, batch %lld)\n",
+            qPrintable(result.name), result.median_ns, result.min_ns,
+            static_cast<long long>(result.batch)
+        );
+        finished.push_back(result);
+    }
+}
+
+const QVector<bench_result>& bench_runner::results() const {
+    return finished;
+}
+
+QByteArray bench_runner::to_json(std::uint64_t seed) const {
+    QJsonArray benchmarks;
+    for (const bench_result& result : finished) {
+        QJsonObject entry;
+        entry.insert(QStringLiteral("name"), result.name);
+        entry.insert(QStringLiteral("batch"), result.batch);
+        entry.insert(QStringLiteral("samples"), result.samples);
+        entry.insert(QStringLiteral("min_ns"), rounded_ns(result.min_ns));
+        entry.insert(
+            QStringLiteral("median_ns"), rounded_ns(result.median_ns)
+        );
+        entry.insert(QStringLiteral("mean_ns"), rounded_ns(result.mean_ns));
+        benchmarks.append(entry);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("format"), kFormatVersion);
+    root.insert(
+        QStringLiteral("build_type"),
+        QString::fromLatin1(KCUCKOUNTER_BUILD_TYPE)
+    );
+    root.insert(QStringLiteral("qt_version"), QString::fromLatin1(qVersion()));
+    root.insert(QStringLiteral("seed"), QString::number(seed));
+    root.insert(QStringLiteral("samples"), samples);
+    root.insert(QStringLiteral("sample_ms"), sample_ns / 1000000);
+    root.insert(QStringLiteral("benchmarks"), benchmarks);
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+qint64 bench_runner::time_batch(const bench_fn& fn, qint64 iterations) {
+    QElapsedTimer timer;
+    timer.start();
+    const std::uint64_t value = fn(iterations);
+    const qint64 elapsed = timer.nsecsElapsed();
+    sink = sink + value;
+    return elapsed;
+}
+
+bench_result bench_runner::run_case(const bench_case& entry) {
+    qint64 batch = 1;
+    while (batch < kMaxBatch && time_batch(entry.fn, batch) < sample_ns) {
+        batch *= 2;
+    }
+    time_batch(entry.fn, batch);
+
+    QVector<double> per_op;
+    per_op.reserve(samples);
+    for (int sample = 0; sample < samples; ++sample) {
+        const qint64 elapsed = time_batch(entry.fn, batch);
+        per_op.push_back(
+            static_cast<double>(elapsed) / static_cast<double>(batch)
+        );
+    }
+    std::sort(per_op.begin(), per_op.end());
+
+    bench_result result;
+    result.name = entry.name;
+    result.batch = batch;
+    result.samples = samples;
+    result.min_ns = per_op.front();
+    result.median_ns = per_op.at(per_op.size() / 2);
+    result.mean_ns = std::accumulate(per_op.begin(), per_op.end(), 0.0)
+        / static_cast<double>(per_op.size());
+    return result;
+}
@@ -0,0 +1,69 @@
+#ifndef KCUCKOUNTER_BENCH_RUNNER_HPP
+#define KCUCKOUNTER_BENCH_RUNNER_HPP
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <cstdint>
+#include <functional>
+
+struct bench_result {
+    QString name;
+    qint64 batch = 0;
+    int samples = 0;
+    double min_ns = 0.0;
+    double median_ns = 0.0;
+    double mean_ns = 0.0;
+};
+
+/**
+ * @brief Times registered micro-benchmarks and reports them as JSON.
+ *
+ * A benchmark is a function that runs its operation a given number of
+ * times and returns a value derived from the results, which the runner
+ * folds into a volatile sink so the work cannot be optimized away. Each
+ * benchmark is first calibrated: the batch size doubles until one batch
+ * takes at least sample_ms. One warm-up batch is then discarded and
+ * `samples` batches are timed; the result holds the minimum, median and
+ * mean time per operation.
+ *
+ * to_json() lists the benchmarks in registration order with sorted keys
+ * and times rounded to 0.001 ns, and holds nothing that changes between
+ * runs other than the measurements, so two reports diff cleanly.
+ */
+class bench_runner {
+public:
+    using bench_fn = std::function<std::uint64_t(qint64 iterations)>;
+
+    static constexpr int default_samples = 15;
+    static constexpr qint64 default_sample_ms = 20;
+
+    bench_runner(QString filter, int samples, qint64 sample_ms);
+
+    void add(const QString& name, bench_fn fn);
+    QStringList names() const;
+    void run_all();
+
+    const QVector<bench_result>& results() const;
+    QByteArray to_json(std::uint64_t seed) const;
+
+private:
+    struct bench_case {
+        QString name;
+        bench_fn fn;
+    };
+
+    qint64 time_batch(const bench_fn& fn, qint64 iterations);
+    bench_result run_case(const bench_case& entry);
+
+    QString filter;
+    int samples;
+    qint64 sample_ns;
+    QVector<bench_case> cases;
+    QVector<bench_result> finished;
+    volatile std::uint64_t sink;
+};
+
+#endif // KCUCKOUNTER_BENCH_RUNNER_HPP
@@ -0,0 +1,339 @@
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QSvgRenderer>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "include/bench_runner.hpp"
+
+#include "card_helpers/card_packer.hpp"
+#include "card_helpers/card_picker.hpp"
+#include "card_helpers/card_sheet.hpp"
+#include "card_helpers/rank_counter.hpp"
+#include "card_helpers/strategy_matrix.hpp"
+#include "helpers/random_generator.hpp"
+#include "helpers/strategy_data.hpp"
+
+namespace {
+constexpr std::uint64_t kDefaultSeed = 20250101;
+constexpr int kCardsPerDeck = 52;
+constexpr int kDecksCount = 8;
+constexpr double kTableWidth = 1280.0;
+constexpr double kTableHeight = 800.0;
+constexpr int kRasterShortPx = 126;
+
+std::uint64_t to_sum(int value) { return static_cast<std::uint64_t>(value); }
+
+// One full shoe in deal order, shared by the counting benchmarks.
+std::vector<int> dealt_shoe() {
+    card_picker picker;
+    picker.setup(kCardsPerDeck, kDecksCount, false);
+    std::vector<int> shoe;
+    shoe.reserve(static_cast<std::size_t>(picker.total_cards()));
+    while (picker.has_cards()) {
+        shoe.push_back(picker.current_card_index());
+        picker.advance();
+    }
+    return shoe;
+}
+
+void add_picker_benchmarks(bench_runner& runner) {
+    runner.add(QStringLiteral("card_picker::setup"), [](qint64 iterations) {
+        card_picker picker;
+        std::uint64_t sum = 0;
+        for (qint64 i = 0; i < iterations; ++i) {
+            picker.setup(kCardsPerDeck, kDecksCount, false);
+            sum += to_sum(picker.current_card_index());
+        }
+        return sum;
+    });
+    runner.add(QStringLiteral("card_picker::advance"), [](qint64 iterations) {
+        card_picker picker;
+        picker.setup(kCardsPerDeck, kDecksCount, true);
+        std::uint64_t sum = 0;
+        for (qint64 i = 0; i < iterations; ++i) {
+            picker.advance();
+            sum += to_sum(picker.current_card_index());
+        }
+        return sum;
+    });
+}
+
+void add_counting_benchmarks(bench_runner& runner) {
+    const std::shared_ptr<const strategy_registry> registry
+        = strategy_registry::load();
+    const std::vector<int> shoe = dealt_shoe();
+    const QVector<int> weights = registry->strategies().isEmpty()
+        ? QVector<int>()
+        : registry->strategies().first().weights;
+
+    runner.add(
+        QStringLiteral("rank_counter::add_card"),
+        [shoe, weights](qint64 iterations) {
+            rank_counter counter;
+            counter.set_weights(weights);
+            std::uint64_t sum = 0;
+            std::size_t position = 0;
+            for (qint64 i = 0; i < iterations; ++i) {
+                if (position == shoe.size()) {
+                    counter.reset();
+                    position = 0;
+                }
+                counter.add_card(shoe[position]);
+                ++position;
+                sum += to_sum(counter.running_count());
+            }
+            return sum;
+        }
+    );
+
+    // Every strategy's count at mid-shoe, as the settings comparison needs.
+    rank_counter half_shoe;
+    for (std::size_t position = 0; position < shoe.size() / 2; ++position) {
+        half_shoe.add_card(shoe[position]);
+    }
+    const std::array<int, rank_counter::ranks_count> seen
+        = half_shoe.seen_counts();
+    runner.add(
+        QStringLiteral("strategy_matrix::running_counts"),
+        [registry, seen](qint64 iterations) {
+            const strategy_matrix& matrix = registry->weight_matrix();
+            std::vector<int> counts;
+            std::uint64_t sum = 0;
+            for (qint64 i = 0; i < iterations; ++i) {
+                matrix.running_counts(seen, counts);
+                sum += to_sum(counts.empty() ? 0 : counts.back());
+            }
+            return sum;
+        }
+    );
+}
+
+void add_packer_benchmarks(bench_runner& runner) {
+    for (const std::size_t count : { std::size_t { 1 }, std::size_t { 8 } }) {
+        runner.add(
+            QStringLiteral("card_packer::pack/%1").arg(count),
+            [count](qint64 iterations) {
+                card_packer packer(count);
+                std::uint64_t sum = 0;
+                for (qint64 i = 0; i < iterations; ++i) {
+                    const auto [scale, cards]
+                        = packer.pack(kTableWidth, kTableHeight);
+                    sum += cards.size() + static_cast<std::uint64_t>(scale);
+                }
+                return sum;
+            }
+        );
+    }
+}
+
+void add_strategy_benchmarks(bench_runner& runner) {
+    runner.add(QStringLiteral("load_strategies"), [](qint64 iterations) {
+        std::uint64_t sum = 0;
+        for (qint64 i = 0; i < iterations; ++i) {
+            sum += to_sum(static_cast<int>(load_strategies().size()));
+        }
+        return sum;
+    });
+    runner.add(
+        QStringLiteral("strategy_registry::load"),
+        [](qint64 iterations) {
+            std::uint64_t sum = 0;
+            for (qint64 i = 0; i < iterations; ++i) {
+                sum += to_sum(static_cast<int>(
+                    strategy_registry::load()->strategies().size()
+                ));
+            }
+            return sum;
+        }
+    );
+
+    QFile file(QStringLiteral("assets/strategies.json"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return;
+    }
+    const QByteArray json = file.readAll();
+    runner.add(
+        QStringLiteral("strategy_registry::from_json"),
+        [json](qint64 iterations) {
+            std::uint64_t sum = 0;
+            for (qint64 i = 0; i < iterations; ++i) {
+                sum += to_sum(static_cast<int>(
+                    strategy_registry::from_json(json)->strategies().size()
+                ));
+            }
+            return sum;
+        }
+    );
+}
+
+void add_card_sheet_benchmarks(bench_runner& runner) {
+    preload_card_sheet();
+    const int sheet_cards
+        = std::max(1, static_cast<int>(card_element_ids().size()));
+    runner.add(
+        QStringLiteral("card_sheet::element_id"),
+        [sheet_cards](qint64 iterations) {
+            std::uint64_t sum = 0;
+            for (qint64 i = 0; i < iterations; ++i) {
+                const int index = static_cast<int>(i % sheet_cards);
+                sum += to_sum(
+                    static_cast<int>(card_element_id_from_index(index).size())
+                );
+            }
+            return sum;
+        }
+    );
+    runner.add(
+        QStringLiteral("card_sheet::label"),
+        [sheet_cards](qint64 iterations) {
+            std::uint64_t sum = 0;
+            for (qint64 i = 0; i < iterations; ++i) {
+                const int index = static_cast<int>(i % sheet_cards);
+                sum += to_sum(
+                    static_cast<int>(card_label_from_index(index).size())
+                );
+            }
+            return sum;
+        }
+    );
+    runner.add(QStringLiteral("card_sheet::ratio"), [](qint64 iterations) {
+        std::uint64_t sum = 0;
+        for (qint64 i = 0; i < iterations; ++i) {
+            sum += to_sum(card_sheet_ratio().first);
+        }
+        return sum;
+    });
+}
+
+void add_raster_benchmarks(bench_runner& runner) {
+    runner.add(QStringLiteral("svg::parse_sheet"), [](qint64 iterations) {
+        std::uint64_t sum = 0;
+        for (qint64 i = 0; i < iterations; ++i) {
+            const QSvgRenderer renderer(card_sheet_source_path());
+            sum += renderer.isValid() ? 1 : 0;
+        }
+        return sum;
+    });
+
+    const std::pair<int, int> ratio = card_sheet_ratio();
+    const QSize size(
+        kRasterShortPx, kRasterShortPx * ratio.first / ratio.second
+    );
+    const QString element_id = card_element_id_from_index(0);
+    runner.add(
+        QStringLiteral("svg::render_element"),
+        [size, element_id](qint64 iterations) {
+            // Mirrors one element of card_widget's raster job.
+            QSvgRenderer renderer(card_sheet_source_path());
+            std::uint64_t sum = 0;
+            for (qint64 i = 0; i < iterations; ++i) {
+                QImage image(size, QImage::Format_ARGB32_Premultiplied);
+                image.fill(Qt::transparent);
+                QPainter painter(&image);
+                renderer.render(
+                    &painter, element_id,
+                    QRectF(QPointF(0.0, 0.0), QSizeF(size))
+                );
+                painter.end();
+                sum += image.pixel(size.width() / 2, size.height() / 2);
+            }
+            return sum;
+        }
+    );
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    // Rasterization needs a GUI application but never a display.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+
+    const QCommandLineOption filter_option(
+        QStringLiteral("filter"),
+        QStringLiteral("Only run benchmarks whose name contains <text>."),
+        QStringLiteral("text")
+    );
+    const QCommandLineOption samples_option(
+        QStringLiteral("samples"),
+        QStringLiteral("Timed batches per benchmark."), QStringLiteral("count"),
+        QString::number(bench_runner::default_samples)
+    );
+    const QCommandLineOption sample_ms_option(
+        QStringLiteral("sample-ms"),
+        QStringLiteral("Minimum duration of one batch."), QStringLiteral("ms"),
+        QString::number(bench_runner::default_sample_ms)
+    );
+    const QCommandLineOption output_option(
+        QStringLiteral("output"),
+        QStringLiteral("Write the JSON report to <file> instead of stdout."),
+        QStringLiteral("file")
+    );
+    const QCommandLineOption list_option(
+        QStringLiteral("list"), QStringLiteral("List the benchmarks and exit.")
+    );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QStringLiteral("Micro-benchmarks of the kcuckounter core.")
+    );
+    parser.addHelpOption();
+    parser.addOption(filter_option);
+    parser.addOption(samples_option);
+    parser.addOption(sample_ms_option);
+    parser.addOption(output_option);
+    parser.addOption(list_option);
+    parser.process(app);
+
+    // Shuffles depend on the master seed; a fixed one keeps every run
+    // dealing the same shoes.
+    random_generator::set_master_seed(kDefaultSeed);
+
+    bench_runner runner(
+        parser.value(filter_option), parser.value(samples_option).toInt(),
+        parser.value(sample_ms_option).toLongLong()
+    );
+    add_picker_benchmarks(runner);
+    add_counting_benchmarks(runner);
+    add_packer_benchmarks(runner);
+    add_strategy_benchmarks(runner);
+    add_card_sheet_benchmarks(runner);
+    add_raster_benchmarks(runner);
+
+    if (parser.isSet(list_option)) {
+        for (const QString& name : runner.names()) {
+            std::printf("%s\n", qPrintable(name));
+        }
+        return 0;
+    }
+
+    runner.run_all();
+    const QByteArray report = runner.to_json(kDefaultSeed);
+    if (!parser.isSet(output_option)) {
+        std::fwrite(
+            report.constData(), 1, static_cast<std::size_t>(report.size()),
+            stdout
+        );
+        return 0;
+    }
+    QFile output(parser.value(output_option));
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || output.write(report) != report.size()) {
+        std::fprintf(
+            stderr, "Cannot write report: %s\n",
+            qPrintable(parser.value(output_option))
+        );
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,396 @@
+# Converts assets/strategies.json into a header of constexpr tables.
+#
+# Usage: cmake -DINPUT=<strategies.json> -DOUTPUT=<strategy_table.hpp>
+#              -P strategy_table.cmake
+#
+# Any malformed entry stops the build with a message naming the strategy and
+# field, so bad data can no longer be dropped silently at runtime.
+
+cmake_minimum_required(VERSION 3.19)
+
+if (NOT DEFINED INPUT OR NOT DEFINED OUTPUT)
+    message(FATAL_ERROR "strategy_table.cmake needs -DINPUT and -DOUTPUT")
+endif ()
+
+file(READ "${INPUT}" json)
+
+set(expected_rank_order A 2 3 4 5 6 7 8 9 10 J Q K)
+list(LENGTH expected_rank_order ranks_count)
+
+function(fail context text)
+    message(FATAL_ERROR "${INPUT}: ${context}: ${text}")
+endfunction()
+
+# json_get(<out> <type> <context> <path...>) reads a member and checks its type.
+function(json_get out type context)
+    string(JSON value_type ERROR_VARIABLE error TYPE "${json}" ${ARGN})
+    if (error)
+        fail("${context}" "missing ${ARGN}")
+    endif ()
+    if (NOT value_type STREQUAL type)
+        fail("${context}" "${ARGN} must be ${type}, got ${value_type}")
+    endif ()
+    string(JSON value GET "${json}" ${ARGN})
+    set(${out} "${value}" PARENT_SCOPE)
+endfunction()
+
+function(json_has out)
+    string(JSON value_type ERROR_VARIABLE error TYPE "${json}" ${ARGN})
+    if (error OR value_type STREQUAL "NULL")
+        set(${out} FALSE PARENT_SCOPE)
+    else ()
+        set(${out} TRUE PARENT_SCOPE)
+    endif ()
+endfunction()
+
+function(cpp_string out text)
+    string(REPLACE "\\" "\\\\" text "${text}")
+    string(REPLACE "\"" "\\\"" text "${text}")
+    string(REPLACE "\n" "\\n" text "${text}")
+    set(${out} "\"${text}\"" PARENT_SCOPE)
+endfunction()
+
+# CMake splits list elements on ';', so text from the JSON never goes through
+# a list: duplicates are tracked by hash and initializers built by appending.
+function(claim_unique context what value)
+    string(MD5 digest "${value}")
+    get_property(taken GLOBAL PROPERTY "strategy_table_${what}_${digest}" SET)
+    if (taken)
+        fail("${context}" "duplicate ${what} ${value}")
+    endif ()
+    set_property(GLOBAL PROPERTY "strategy_table_${what}_${digest}" TRUE)
+endfunction()
+
+# Member names are passed as JSON paths, which are lists.
+function(require_plain_key context key)
+    if (key MATCHES ";")
+        fail("${context}" "key '${key}' must not contain ';'")
+    endif ()
+endfunction()
+
+function(require_integer context field value)
+    if (NOT value MATCHES "^-?[0-9]+$")
+        fail("${context}" "${field} must be an integer, got ${value}")
+    endif ()
+endfunction()
+
+# card_rank_order must match the rank layout of card_sheet.
+json_get(rank_order ARRAY "card_rank_order" card_rank_order)
+string(JSON rank_order_length LENGTH "${json}" card_rank_order)
+if (NOT rank_order_length EQUAL ranks_count)
+    fail("card_rank_order" "expected ${ranks_count} ranks")
+endif ()
+math(EXPR last_rank "${ranks_count} - 1")
+foreach (rank_index RANGE ${last_rank})
+    string(JSON rank GET "${json}" card_rank_order ${rank_index})
+    list(GET expected_rank_order ${rank_index} expected_rank)
+    if (NOT rank STREQUAL expected_rank)
+        fail("card_rank_order" "rank ${rank_index} is ${rank}, expected ${expected_rank}")
+    endif ()
+endforeach ()
+
+set(authors_items "")
+set(games_items "")
+set(metrics_items "")
+set(fields_items "")
+set(refs_items "")
+set(entries_items "")
+set(authors_total 0)
+set(games_total 0)
+set(metrics_total 0)
+set(fields_total 0)
+set(refs_total 0)
+
+json_get(strategies_json ARRAY "strategies" strategies)
+string(JSON strategies_count LENGTH "${json}" strategies)
+if (strategies_count EQUAL 0)
+    fail("strategies" "no strategies defined")
+endif ()
+math(EXPR last_strategy "${strategies_count} - 1")
+
+foreach (index RANGE ${last_strategy})
+    set(context "strategies[${index}]")
+    json_get(id NUMBER "${context}" strategies ${index} id)
+    require_integer("${context}" id "${id}")
+    json_get(slug STRING "${context}" strategies ${index} slug)
+    json_get(name STRING "${context}" strategies ${index} name)
+    set(context "strategy '${name}'")
+
+    if (name STREQUAL "" OR slug STREQUAL "")
+        fail("${context}" "name and slug must not be empty")
+    endif ()
+    claim_unique("${context}" id "${id}")
+    claim_unique("${context}" slug "${slug}")
+    claim_unique("${context}" name "${name}")
+
+    set(date "")
+    json_has(has_date strategies ${index} date)
+    if (has_date)
+        json_get(date STRING "${context}" strategies ${index} date)
+    endif ()
+    json_get(description STRING "${context}" strategies ${index} description)
+    json_get(min_decks NUMBER "${context}" strategies ${index} min_decks)
+    require_integer("${context}" min_decks "${min_decks}")
+    if (min_decks LESS 0)
+        fail("${context}" "min_decks must not be negative")
+    endif ()
+    json_get(balance BOOLEAN "${context}" strategies ${index} balance)
+    json_get(ace_neutral BOOLEAN "${context}" strategies ${index} ace_neutral)
+
+    json_get(weights_json ARRAY "${context}" strategies ${index} weights)
+    string(JSON weights_count LENGTH "${json}" strategies ${index} weights)
+    if (NOT weights_count EQUAL ranks_count)
+        fail("${context}" "weights must have ${ranks_count} entries aligned to card_rank_order, got ${weights_count}")
+    endif ()
+    set(weights "")
+    foreach (rank_index RANGE ${last_rank})
+        json_get(weight NUMBER "${context}" strategies ${index} weights ${rank_index})
+        require_integer("${context}" "weights[${rank_index}]" "${weight}")
+        list(APPEND weights "${weight}")
+    endforeach ()
+    list(JOIN weights ", " weights)
+
+    set(authors_begin ${authors_total})
+    json_get(authors_json ARRAY "${context}" strategies ${index} authors)
+    string(JSON count LENGTH "${json}" strategies ${index} authors)
+    if (count GREATER 0)
+        math(EXPR last "${count} - 1")
+        foreach (item RANGE ${last})
+            json_get(author STRING "${context}" strategies ${index} authors ${item})
+            cpp_string(author "${author}")
+            string(APPEND authors_items "    ${author},\n")
+        endforeach ()
+    endif ()
+    math(EXPR authors_total "${authors_total} + ${count}")
+    set(authors_count ${count})
+
+    set(games_begin ${games_total})
+    json_get(games_json ARRAY "${context}" strategies ${index} games)
+    string(JSON count LENGTH "${json}" strategies ${index} games)
+    if (count GREATER 0)
+        math(EXPR last "${count} - 1")
+        foreach (item RANGE ${last})
+            json_get(game STRING "${context}" strategies ${index} games ${item})
+            cpp_string(game "${game}")
+            string(APPEND games_items "    ${game},\n")
+        endforeach ()
+    endif ()
+    math(EXPR games_total "${games_total} + ${count}")
+    set(games_count ${count})
+
+    set(metrics_begin ${metrics_total})
+    set(count 0)
+    json_has(has_metrics strategies ${index} metrics)
+    if (has_metrics)
+        json_get(metrics_json OBJECT "${context}" strategies ${index} metrics)
+        string(JSON count LENGTH "${json}" strategies ${index} metrics)
+        if (count GREATER 0)
+            math(EXPR last "${count} - 1")
+            foreach (item RANGE ${last})
+                string(JSON key MEMBER "${json}" strategies ${index} metrics ${item})
+                require_plain_key("${context}" "${key}")
+                json_get(value NUMBER "${context}" strategies ${index} metrics ${key})
+                if (NOT value MATCHES "[.eE]")
+                    string(APPEND value ".0")
+                endif ()
+                cpp_string(key "${key}")
+                string(APPEND metrics_items "    metric { ${key}, ${value} },\n")
+            endforeach ()
+        endif ()
+    endif ()
+    math(EXPR metrics_total "${metrics_total} + ${count}")
+    set(metrics_count ${count})
+
+    set(fields_begin ${fields_total})
+    set(count 0)
+    json_has(has_fields strategies ${index} unique_fields)
+    if (has_fields)
+        json_get(fields_json OBJECT "${context}" strategies ${index} unique_fields)
+        string(JSON count LENGTH "${json}" strategies ${index} unique_fields)
+        if (count GREATER 0)
+            math(EXPR last "${count} - 1")
+            foreach (item RANGE ${last})
+                string(JSON key MEMBER "${json}" strategies ${index} unique_fields ${item})
+                require_plain_key("${context}" "${key}")
+                json_get(value STRING "${context}" strategies ${index} unique_fields ${key})
+                cpp_string(key "${key}")
+                cpp_string(value "${value}")
+                string(APPEND fields_items "    text_field { ${key}, ${value} },\n")
+            endforeach ()
+        endif ()
+    endif ()
+    math(EXPR fields_total "${fields_total} + ${count}")
+    set(fields_count ${count})
+
+    set(refs_begin ${refs_total})
+    set(count 0)
+    json_has(has_refs strategies ${index} refs)
+    if (has_refs)
+        json_get(refs_json ARRAY "${context}" strategies ${index} refs)
+        string(JSON count LENGTH "${json}" strategies ${index} refs)
+        if (count GREATER 0)
+            math(EXPR last "${count} - 1")
+            foreach (item RANGE ${last})
+                set(ref_values "")
+                set(separator "")
+                foreach (ref_key type citation url accessed)
+                    set(ref_value "")
+                    json_has(has_value strategies ${index} refs ${item} ${ref_key})
+                    if (has_value)
+                        json_get(ref_value STRING "${context}" strategies ${index} refs ${item} ${ref_key})
+                    endif ()
+                    if (ref_key STREQUAL "citation" AND ref_value STREQUAL "")
+                        fail("${context}" "refs[${item}] has no citation")
+                    endif ()
+                    cpp_string(ref_value "${ref_value}")
+                    string(APPEND ref_values "${separator}${ref_value}")
+                    set(separator ", ")
+                endforeach ()
+                string(APPEND refs_items "    reference { ${ref_values} },\n")
+            endforeach ()
+        endif ()
+    endif ()
+    math(EXPR refs_total "${refs_total} + ${count}")
+    set(refs_count ${count})
+
+    cpp_string(slug "${slug}")
+    cpp_string(name "${name}")
+    cpp_string(date "${date}")
+    cpp_string(description "${description}")
+    if (balance)
+        set(balance true)
+    else ()
+        set(balance false)
+    endif ()
+    if (ace_neutral)
+        set(ace_neutral true)
+    else ()
+        set(ace_neutral false)
+    endif ()
+
+    string(APPEND entries_items
+            "    entry {\n"
+            "        ${id},\n"
+            "        ${slug},\n"
+            "        ${name},\n"
+            "        ${date},\n"
+            "        ${description},\n"
+            "        ${min_decks},\n"
+            "        ${balance},\n"
+            "        ${ace_neutral},\n"
+            "        { ${weights} },\n"
+            "        { ${authors_begin}, ${authors_count} },\n"
+            "        { ${games_begin}, ${games_count} },\n"
+            "        { ${metrics_begin}, ${metrics_count} },\n"
+            "        { ${fields_begin}, ${fields_count} },\n"
+            "        { ${refs_begin}, ${refs_count} },\n"
+            "    },\n"
+    )
+endforeach ()
+
+set(descriptions_items "")
+set(descriptions_total 0)
+json_has(has_descriptions key_descriptions)
+if (has_descriptions)
+    json_get(descriptions_json OBJECT "key_descriptions" key_descriptions)
+    string(JSON descriptions_total LENGTH "${json}" key_descriptions)
+    if (descriptions_total GREATER 0)
+        math(EXPR last "${descriptions_total} - 1")
+        foreach (item RANGE ${last})
+            string(JSON key MEMBER "${json}" key_descriptions ${item})
+            require_plain_key("key_descriptions" "${key}")
+            json_get(value STRING "key_descriptions" key_descriptions ${key})
+            cpp_string(key "${key}")
+            cpp_string(value "${value}")
+            string(APPEND descriptions_items "    text_field { ${key}, ${value} },\n")
+        endforeach ()
+    endif ()
+endif ()
+
+set(header [=[
+// Generated from assets/strategies.json by cmake/strategy_table.cmake.
+// Do not edit; change the JSON and rebuild instead.
+#ifndef KCUCKOUNTER_GENERATED_STRATEGY_TABLE_HPP
+#define KCUCKOUNTER_GENERATED_STRATEGY_TABLE_HPP
+
+#include <array>
+#include <string_view>
+
+namespace strategy_table {
+
+inline constexpr int ranks_count = @ranks_count@;
+
+struct span {
+    int begin;
+    int count;
+};
+
+struct metric {
+    std::string_view key;
+    double value;
+};
+
+struct text_field {
+    std::string_view key;
+    std::string_view value;
+};
+
+struct reference {
+    std::string_view type;
+    std::string_view citation;
+    std::string_view url;
+    std::string_view accessed;
+};
+
+struct entry {
+    int id;
+    std::string_view slug;
+    std::string_view name;
+    std::string_view date;
+    std::string_view description;
+    int min_decks;
+    bool balance;
+    bool ace_neutral;
+    std::array<int, ranks_count> weights;
+    span authors;
+    span games;
+    span metrics;
+    span unique_fields;
+    span references;
+};
+
+inline constexpr std::array<std::string_view, @authors_total@> authors = {
+@authors_items@};
+
+inline constexpr std::array<std::string_view, @games_total@> games = {
+@games_items@};
+
+inline constexpr std::array<metric, @metrics_total@> metrics = {
+@metrics_items@};
+
+inline constexpr std::array<text_field, @fields_total@> unique_fields = {
+@fields_items@};
+
+inline constexpr std::array<reference, @refs_total@> references = {
+@refs_items@};
+
+inline constexpr std::array<text_field, @descriptions_total@> key_descriptions = {
+@descriptions_items@};
+
+inline constexpr std::array<entry, @strategies_count@> entries = {
+@entries_items@};
+
+} // namespace strategy_table
+
+#endif // KCUCKOUNTER_GENERATED_STRATEGY_TABLE_HPP
+]=])
+string(CONFIGURE "${header}" header @ONLY)
+
+# Only touch the output when it changes so dependents do not rebuild.
+set(previous "")
+if (EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" previous)
+endif ()
+if (NOT previous STREQUAL header)
+    file(WRITE "${OUTPUT}" "${header}")
+endif ()
@@ -1,15 +1,29 @@
 #ifndef KCUCKOUNTER_CARD_HELPERS_CARD_PICKER_HPP
 #define KCUCKOUNTER_CARD_HELPERS_CARD_PICKER_HPP
 
+#include "card_helpers/shoe_bank.hpp"
 #include "helpers/random_generator.hpp"
-#include <vector>
+#include <memory>
 
+/**
+ * @brief Handle to one slot of a shoe_bank.
+ *
+ * A default-constructed picker owns a private bank; attach() moves it into a
+ * bank shared with other pickers so all their shoes live in one buffer.
+ */
 class card_picker {
 public:
     card_picker();
+    explicit card_picker(std::shared_ptr<shoe_bank> bank);
+    ~card_picker();
 
+    card_picker(const card_picker&) = delete;
+    card_picker& operator=(const card_picker&) = delete;
+
+    void attach(std::shared_ptr<shoe_bank> bank);
     void setup(int cards_per_deck, int decks_count, bool infinity_enabled);
     void set_infinity(bool enabled);
+    void reseed(const random_generator& generator);
     void advance();
     void mark_depleted();
 
@@ -19,15 +33,11 @@ public:
     int total_cards() const;
     bool is_depleted() const;
     int card_index_at(int position) const;
+    int remaining_of_rank(int bucket) const;
 
 private:
-    void fill_deck(int cards_per_deck, int decks_count);
-    void shuffle_deck();
-
-    std::vector<int> deck;
-    int deck_position;
-    bool infinity;
-    random_generator random_gen;
+    std::shared_ptr<shoe_bank> shoes;
+    int slot;
 };
 
 #endif // KCUCKOUNTER_CARD_HELPERS_CARD_PICKER_HPP
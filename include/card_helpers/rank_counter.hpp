@@ -0,0 +1,59 @@
+#ifndef KCUCKOUNTER_CARD_HELPERS_RANK_COUNTER_HPP
+#define KCUCKOUNTER_CARD_HELPERS_RANK_COUNTER_HPP
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief Incremental running count over the cards dealt from a shoe.
+ *
+ * Keeps how many cards of each rank have been seen since the last reset
+ * together with the weighted sum of those cards for the active strategy.
+ * Adding a card and reading the count are O(1); switching the strategy
+ * re-weights the 13 per-rank counters instead of walking the dealt cards.
+ *
+ * Card indices follow card_sheet: 0..51 are rank-major within each suit
+ * (index % 13 is the rank in card_rank_order), 52 and above are jokers,
+ * which carry no weight.
+ */
+class rank_counter {
+public:
+    static constexpr int ranks_count = 13;
+
+    rank_counter();
+
+    void reset();
+    void add_card(int card_index);
+
+    template <typename Range> void set_weights(const Range& weights) {
+        rank_weights.fill(0);
+        int rank_index = 0;
+        for (const int weight : weights) {
+            if (rank_index >= ranks_count) {
+                break;
+            }
+            rank_weights[static_cast<std::size_t>(rank_index)] = weight;
+            ++rank_index;
+        }
+        recompute();
+    }
+
+    int running_count() const;
+    int seen_count(int rank_index) const;
+    int jokers_seen() const;
+    int total_seen() const;
+    const std::array<int, ranks_count>& seen_counts() const;
+
+    static int rank_from_card_index(int card_index);
+
+private:
+    void recompute();
+
+    std::array<int, ranks_count> rank_weights;
+    std::array<int, ranks_count> rank_seen;
+    int jokers_seen_value;
+    int total_seen_value;
+    int running_count_value;
+};
+
+#endif // KCUCKOUNTER_CARD_HELPERS_RANK_COUNTER_HPP
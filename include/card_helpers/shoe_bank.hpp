@@ -0,0 +1,89 @@
+#ifndef KCUCKOUNTER_CARD_HELPERS_SHOE_BANK_HPP
+#define KCUCKOUNTER_CARD_HELPERS_SHOE_BANK_HPP
+
+#include "helpers/random_generator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Shoes of many slots packed into one contiguous byte buffer.
+ *
+ * Every slot owns a region of the shared buffer holding one byte per card
+ * (the card_sheet index), plus entries in parallel per-slot arrays: region
+ * offset and size, deal cursor, infinity flag, generator and the number of
+ * cards of each rank still waiting in the shoe. Dealing, depletion checks
+ * and rank counts are plain array accesses indexed by the slot id.
+ *
+ * Shuffling is lazy: a pass starts with every position implicitly holding
+ * position % cards_per_deck, and each deal swaps a random not yet dealt
+ * position into the cursor (one Fisher-Yates step). A parallel stamp buffer
+ * marks positions written during the current pass, so starting a pass only
+ * bumps the slot's pass number. Positions past the cursor are not drawn yet
+ * and card_index_at() reports their placeholder value.
+ *
+ * Slot ids are reused after remove_slot(). Regions that no longer fit are
+ * moved to the end of the buffer; the buffer is compacted once more than
+ * half of it is unused.
+ */
+class shoe_bank {
+public:
+    /// 13 ranks in card_rank_order followed by one bucket for jokers.
+    static constexpr int rank_buckets = 14;
+    static constexpr int max_cards_per_deck = 256;
+
+    shoe_bank();
+
+    int add_slot();
+    void remove_slot(int slot);
+    int slot_count() const;
+
+    void setup(int slot, int cards_per_deck, int decks_count, bool infinity);
+    void reseed(int slot, const random_generator& generator);
+    const random_generator& generator(int slot) const;
+    void set_infinity(int slot, bool enabled);
+    void advance(int slot);
+    void mark_depleted(int slot);
+
+    bool has_cards(int slot) const;
+    int current_card_index(int slot) const;
+    int current_position(int slot) const;
+    int total_cards(int slot) const;
+    bool is_depleted(int slot) const;
+    bool is_infinity(int slot) const;
+    int card_index_at(int slot, int position) const;
+    int remaining_cards(int slot) const;
+    int remaining_of_rank(int slot, int bucket) const;
+    std::size_t buffer_size() const;
+
+    static int rank_bucket(int card_index);
+
+private:
+    bool is_valid_slot(int slot) const;
+    void reserve_cards(std::size_t slot, int count);
+    void compact();
+    void start_pass(std::size_t slot);
+    void reset_remaining(std::size_t slot);
+    void draw_current_card(std::size_t slot);
+    int card_at(std::size_t slot, int position) const;
+    void store_card(std::size_t slot, int position, int card_index);
+
+    std::vector<std::uint8_t> cards;
+    std::vector<std::uint8_t> stamps;
+    std::vector<int> slot_offsets;
+    std::vector<int> slot_capacities;
+    std::vector<int> slot_sizes;
+    std::vector<int> slot_cursors;
+    std::vector<int> slot_cards_per_deck;
+    std::vector<int> slot_decks;
+    std::vector<std::uint8_t> slot_passes;
+    std::vector<std::uint8_t> slot_infinity;
+    std::vector<std::uint8_t> slot_active;
+    std::vector<int> rank_remaining;
+    std::vector<random_generator> generators;
+    std::vector<int> free_slots;
+    int active_slots;
+    int unused_cards;
+};
+
+#endif // KCUCKOUNTER_CARD_HELPERS_SHOE_BANK_HPP
@@ -0,0 +1,68 @@
+#ifndef KCUCKOUNTER_CARD_HELPERS_STRATEGY_MATRIX_HPP
+#define KCUCKOUNTER_CARD_HELPERS_STRATEGY_MATRIX_HPP
+
+#include "card_helpers/rank_counter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Weights of many strategies evaluated against one set of seen ranks.
+ *
+ * The 13 x S weight matrix is stored as int16 in rank-pair-interleaved
+ * rows: for every pair of ranks (2p, 2p + 1) and strategy s the two weights
+ * sit next to each other, padded to a multiple of lanes strategies. A
+ * running count for all strategies is then a matrix-vector product of 7
+ * multiply-add steps per lane block, which maps directly onto SSE2's
+ * pmaddwd (int16 x int16 pairs summed into int32 lanes). Builds without
+ * SSE2 run the same layout through a scalar loop.
+ *
+ * Per-rank seen counts come from rank_counter; they are accumulated per
+ * dealt card, so no per-card work over strategies is needed. Weights are
+ * clamped to the int16 range.
+ */
+class strategy_matrix {
+public:
+    static constexpr int ranks_count = rank_counter::ranks_count;
+    static constexpr int rank_pairs = (ranks_count + 1) / 2;
+    static constexpr int lanes = 4;
+
+    strategy_matrix();
+
+    void clear();
+
+    template <typename Range> int add_strategy(const Range& weights) {
+        std::array<int, ranks_count> row {};
+        int rank_index = 0;
+        for (const int weight : weights) {
+            if (rank_index >= ranks_count) {
+                break;
+            }
+            row[static_cast<std::size_t>(rank_index)] = weight;
+            ++rank_index;
+        }
+        return add_row(row);
+    }
+
+    int strategies_count() const;
+    int weight(int strategy, int rank_index) const;
+
+    void running_counts(
+        const std::array<int, ranks_count>& seen, std::vector<int>& counts
+    ) const;
+    std::vector<int>
+    running_counts(const std::array<int, ranks_count>& seen) const;
+
+private:
+    int add_row(const std::array<int, ranks_count>& row);
+    std::size_t padded_count() const;
+    void grow(std::size_t padded);
+
+    std::vector<std::int16_t> weights;
+    std::size_t padded_strategies;
+    int strategies;
+};
+
+#endif // KCUCKOUNTER_CARD_HELPERS_STRATEGY_MATRIX_HPP
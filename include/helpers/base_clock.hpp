@@ -47,6 +47,7 @@ private:
     struct base_clock_state;
     std::unique_ptr<base_clock_state> state;
 
+    qint64 running_elapsed_ms() const;
     void on_timeout();
 };
 
@@ -1,28 +1,48 @@
 #ifndef KCUCKOUNTER_HELPERS_CARD_PREVIEW_CAROUSEL_HPP
 #define KCUCKOUNTER_HELPERS_CARD_PREVIEW_CAROUSEL_HPP
 
+#include "helpers/memory_report.hpp"
 #include "helpers/widget_helpers.hpp"
 
+#include <QImage>
 #include <QLabel>
 #include <QPixmap>
 #include <QSize>
+#include <QString>
 #include <QToolButton>
 #include <QVector>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 
 class QHBoxLayout;
 class QResizeEvent;
 
+/**
+ * @brief Row of card previews with previous/next arrows.
+ *
+ * Cards come either from a fixed pixmap list or from a provider that is run
+ * on the thread pool. Provider-backed cards show a placeholder until their
+ * image arrives; requests for cards that scrolled out of view before a
+ * worker picked them up are skipped, and late results are dropped. A
+ * provider given a cache tag renders at preview_cache bucket sizes and
+ * shares its results with every other carousel using the same tag.
+ */
 class card_preview_carousel : public BaseWidget {
     Q_OBJECT
 
 public:
+    /// Renders one card; called on a worker thread, so it must not touch
+    /// widgets or pixmaps.
+    using card_renderer = std::function<QImage(int, const QSize&)>;
+
     explicit card_preview_carousel(BaseWidget* parent = nullptr);
 
     void set_cards(const QVector<QPixmap>& cards);
     void set_card_provider(
-        int count, std::function<QPixmap(int, const QSize&)> provider
+        int count, card_renderer provider, const QString& cache_tag = QString()
     );
     void set_visible_count(int count);
     void set_visible_range(int min_count, int max_count);
@@ -38,16 +58,36 @@ private slots:
     void show_next();
 
 private:
+    struct view_window {
+        std::atomic<std::uint64_t> generation = 0;
+        std::atomic<int> first = 0;
+        std::atomic<int> span = 0;
+        std::atomic<int> total = 0;
+
+        bool wants(int card_index, std::uint64_t request_generation) const;
+    };
+
     void rebuild_labels();
     void update_visible_count();
     void update_card_dimensions();
     void refresh_view();
+    void request_card(int card_index);
+    void show_card(int card_index);
+    void publish_window();
+    const QPixmap& placeholder();
+    QSize render_size() const;
 
     void clear_cached_cards();
+    void report_cache_bytes();
 
     QVector<QPixmap> cached_cards;
-    std::function<QPixmap(int, const QSize&)> card_provider;
+    QVector<bool> pending_cards;
+    card_renderer card_provider;
+    QString provider_cache_tag;
+    std::shared_ptr<view_window> window;
+    QPixmap placeholder_pixmap;
     QVector<QLabel*> card_labels;
+    memory_account cache_memory;
     int first_index;
     int visible_count_value;
     int min_visible_count_value;
@@ -0,0 +1,86 @@
+#ifndef KCUCKOUNTER_HELPERS_DEAL_SCHEDULER_HPP
+#define KCUCKOUNTER_HELPERS_DEAL_SCHEDULER_HPP
+
+#include "helpers/time_source.hpp"
+
+#include <QObject>
+
+#include <cstdint>
+#include <memory>
+
+enum class catch_up_policy { drop, burst, stretch };
+
+/**
+ * @brief Absolute-deadline arithmetic behind deal_scheduler.
+ *
+ * Deals are due at start + k * interval, in nanoseconds of a monotonic
+ * clock, so timer latency never accumulates into drift. When a wakeup is
+ * late by more than one interval the policy decides what happens to the
+ * missed deals: drop skips them and stays on the grid, burst deals them
+ * (at most max_burst per wakeup, the rest on the immediately following
+ * wakeups) and stretch deals one card and restarts the grid from now.
+ */
+class deal_timeline {
+public:
+    static constexpr std::int64_t min_interval_ns = 16000000;
+    static constexpr int max_burst = 4;
+
+    deal_timeline();
+
+    void set_interval(std::int64_t interval_ns, std::int64_t now_ns);
+    void set_policy(catch_up_policy policy);
+    void start(std::int64_t now_ns);
+    void pause(std::int64_t now_ns);
+    void resume(std::int64_t now_ns);
+    void stop();
+
+    int take_due(std::int64_t now_ns);
+
+    bool is_running() const;
+    bool is_paused() const;
+    std::int64_t interval() const;
+    std::int64_t next_deadline() const;
+    catch_up_policy policy() const;
+
+private:
+    std::int64_t interval_ns;
+    std::int64_t next_deadline_ns;
+    std::int64_t paused_remaining_ns;
+    catch_up_policy current_policy;
+    bool running;
+    bool paused;
+};
+
+/**
+ * @brief Precise timer that emits deal_due() on a deal_timeline.
+ *
+ * A single-shot precise timer is re-armed for the next absolute deadline
+ * after every wakeup, so intervals down to deal_timeline::min_interval_ns
+ * are evenly spaced instead of being quantized to a coarse tick.
+ */
+class deal_scheduler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit deal_scheduler(QObject* parent = nullptr);
+
+    void set_interval_ms(int interval_ms);
+    void set_policy(catch_up_policy policy);
+    void set_active(bool active);
+    void stop();
+    bool is_running() const;
+
+signals:
+    void deal_due();
+
+private:
+    void on_timeout();
+    void arm();
+    std::int64_t now_ns() const;
+
+    std::shared_ptr<time_source> source;
+    std::unique_ptr<time_source::timer> timer;
+    deal_timeline timeline;
+};
+
+#endif // KCUCKOUNTER_HELPERS_DEAL_SCHEDULER_HPP
@@ -0,0 +1,40 @@
+#ifndef KCUCKOUNTER_HELPERS_FRAME_CLOCK_HPP
+#define KCUCKOUNTER_HELPERS_FRAME_CLOCK_HPP
+
+#include "helpers/time_source.hpp"
+
+#include <QObject>
+
+#include <memory>
+
+/**
+ * @brief Animation clock paced to the primary screen's refresh rate.
+ *
+ * One instance drives every animation of its owner in a single pass per
+ * frame. It only runs between wake() and stop(), so an idle owner causes
+ * no wakeups at all.
+ */
+class frame_clock : public QObject {
+    Q_OBJECT
+
+public:
+    explicit frame_clock(QObject* parent = nullptr);
+
+    void wake();
+    void stop();
+    bool is_active() const;
+    int frame_interval_ms() const;
+
+signals:
+    void frame(qint64 delta_ms);
+
+private:
+    void on_timeout();
+    void update_frame_interval();
+
+    std::shared_ptr<time_source> source;
+    std::unique_ptr<time_source::timer> timer;
+    std::int64_t last_frame_ns;
+};
+
+#endif // KCUCKOUNTER_HELPERS_FRAME_CLOCK_HPP
@@ -1,6 +1,8 @@
 #ifndef KCUCKOUNTER_HELPERS_IMAGE_CACHER_HPP
 #define KCUCKOUNTER_HELPERS_IMAGE_CACHER_HPP
 
+#include "helpers/memory_report.hpp"
+
 #include <QPixmap>
 #include <QSize>
 #include <QString>
@@ -27,6 +29,7 @@ private:
     QSvgRenderer renderer;
     qreal base_scale;
     int min_short_px;
+    memory_account cache_memory;
 
     QSize raster_cache_size(const QSize& desired_size) const;
     void rasterize();
@@ -0,0 +1,56 @@
+#ifndef KCUCKOUNTER_HELPERS_MEMORY_REPORT_HPP
+#define KCUCKOUNTER_HELPERS_MEMORY_REPORT_HPP
+
+#include "helpers/trace_recorder.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct memory_usage {
+    const char* subsystem;
+    trace_counter counter;
+    std::int64_t bytes;
+    std::int64_t peak_bytes;
+};
+
+/**
+ * @brief Bytes one object holds in one accounted subsystem.
+ *
+ * set() moves the subsystem's counter by the change since the last call;
+ * the destructor gives back whatever is still held, so owners only report
+ * their new size whenever their caches change.
+ */
+class memory_account {
+public:
+    explicit memory_account(trace_counter counter);
+    ~memory_account();
+
+    memory_account(const memory_account&) = delete;
+    memory_account& operator=(const memory_account&) = delete;
+
+    void set(std::int64_t bytes);
+    std::int64_t bytes() const;
+
+private:
+    trace_counter counter;
+    std::int64_t held;
+};
+
+/**
+ * @brief Current and peak bytes held by each accounted subsystem.
+ *
+ * Read from the trace_recorder *_bytes counters, in a fixed order: card
+ * face rasters, scaled card faces, table markings, card previews and slot
+ * widgets. Pixel buffers are counted at width x height x depth, once per
+ * holder even when Qt shares the data; Qt's own bookkeeping is not counted.
+ */
+std::vector<memory_usage> memory_usage_by_subsystem();
+
+std::string format_memory_bytes(std::int64_t bytes);
+
+/// One line per subsystem plus a total, for the --mem-report flag and the
+/// debug menu.
+std::string memory_report_text();
+
+#endif // KCUCKOUNTER_HELPERS_MEMORY_REPORT_HPP
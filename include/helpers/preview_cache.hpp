@@ -0,0 +1,48 @@
+#ifndef KCUCKOUNTER_HELPERS_PREVIEW_CACHE_HPP
+#define KCUCKOUNTER_HELPERS_PREVIEW_CACHE_HPP
+
+#include "helpers/memory_report.hpp"
+
+#include <QCache>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+
+/**
+ * @brief Process-wide cache of rendered card previews.
+ *
+ * Entries are keyed by a caller tag (suit, weight overlay, ...), the card
+ * index and a size bucket, so carousels in different dialogs, and the same
+ * dialog opened again, reuse each other's renders. Sizes are rounded up to
+ * the bucket grid; previews are drawn scaled, so a render serves every size
+ * inside its bucket. Bounded by pixel memory and used from the GUI thread
+ * only.
+ */
+class preview_cache {
+public:
+    static constexpr int size_bucket_px = 16;
+    static constexpr qsizetype default_budget_kb = 48 * 1024;
+
+    static preview_cache& instance();
+    static QSize bucket_size(const QSize& size);
+
+    preview_cache(const preview_cache&) = delete;
+    preview_cache& operator=(const preview_cache&) = delete;
+
+    QPixmap find(const QString& tag, int card_index, const QSize& size) const;
+    void insert(
+        const QString& tag, int card_index, const QSize& size,
+        const QPixmap& pixmap
+    );
+    void clear();
+
+private:
+    preview_cache();
+
+    static QString key_for(const QString& tag, int card_index, QSize size);
+
+    QCache<QString, QPixmap> entries;
+    memory_account memory;
+};
+
+#endif // KCUCKOUNTER_HELPERS_PREVIEW_CACHE_HPP
@@ -2,21 +2,64 @@
 #define KCUCKOUNTER_HELPERS_RANDOM_GENERATOR_HPP
 
 #include <algorithm>
-#include <random>
+#include <cstdint>
+#include <iterator>
 
+/**
+ * @brief Small-state PCG32 (XSH-RR) generator with seedable streams.
+ *
+ * Every generator is identified by a (seed, stream) pair; two generators with
+ * the same pair produce the same sequence and generators on different streams
+ * of one seed are statistically independent. Default-constructed generators
+ * use the process-wide master seed and take the next free stream, so a fixed
+ * master seed (see set_master_seed()) makes a whole session reproducible as
+ * long as objects are created in the same order.
+ *
+ * Bounded integers use Lemire's multiply-shift rejection method and are free
+ * of modulo bias; shuffle() is a Fisher-Yates pass on top of it.
+ */
 class random_generator {
 public:
+    using result_type = std::uint32_t;
+
     random_generator();
+    random_generator(std::uint64_t seed, std::uint64_t stream);
+
+    static void set_master_seed(std::uint64_t seed);
+    static std::uint64_t master_seed();
+    static bool has_fixed_master_seed();
+    static std::uint64_t derive_seed(std::uint64_t seed, std::uint64_t index);
+
+    void reseed(std::uint64_t seed, std::uint64_t stream);
+    random_generator split(std::uint64_t index) const;
+    std::uint64_t seed() const;
+    std::uint64_t stream() const;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()();
 
+    std::uint32_t bounded(std::uint32_t bound);
     int uniform_int(int min, int max);
     double uniform_real(double min, double max);
 
     template <typename It> void shuffle(It begin, It end) {
-        std::shuffle(begin, end, engine);
+        using difference_type =
+            typename std::iterator_traits<It>::difference_type;
+        const difference_type count = std::distance(begin, end);
+        for (difference_type index = count - 1; index > 0; --index) {
+            const auto pick = static_cast<difference_type>(
+                bounded(static_cast<std::uint32_t>(index + 1))
+            );
+            std::iter_swap(begin + index, begin + pick);
+        }
     }
 
 private:
-    std::mt19937 engine;
+    std::uint64_t state;
+    std::uint64_t increment;
+    std::uint64_t seed_value;
+    std::uint64_t stream_value;
 };
 
 #endif // KCUCKOUNTER_HELPERS_RANDOM_GENERATOR_HPP
@@ -0,0 +1,114 @@
+#ifndef KCUCKOUNTER_HELPERS_SESSION_LOG_HPP
+#define KCUCKOUNTER_HELPERS_SESSION_LOG_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class session_event_kind : std::uint8_t {
+    session_start = 1,
+    slot_setup = 2,
+    pick = 3,
+    quiz_answer = 4,
+    quiz_skip = 5,
+    quiz_continue = 6,
+    infinity_toggled = 7,
+    paused = 8,
+    game_over = 9
+};
+
+struct session_header {
+    std::uint64_t seed = 0;
+    int quiz_type = 0;
+    int dealing_mode = 0;
+    bool wait_for_answers = false;
+};
+
+struct session_slot_setup {
+    int slot = 0;
+    std::uint64_t stream = 0;
+    int cards_per_deck = 0;
+    int decks_count = 0;
+    bool infinity = false;
+    std::vector<int> weights;
+};
+
+/**
+ * @brief One timestamped entry of a recorded session.
+ *
+ * The meaning of value, expected and flag depends on the kind: the dealt
+ * card index for picks, the provided and expected count for quiz answers
+ * and skips (flag marks training mode), the new state for infinity and
+ * pause toggles.
+ */
+struct session_event {
+    session_event_kind kind = session_event_kind::pick;
+    std::int64_t time_ms = 0;
+    int slot = -1;
+    int value = 0;
+    int expected = 0;
+    bool flag = false;
+};
+
+/**
+ * @brief Decoded session recording.
+ *
+ * The file starts with the "KCSR" magic and a format version, followed by
+ * records of one kind byte, the time since the previous record as a varint
+ * and a kind-specific varint payload (signed values are zigzag encoded).
+ * Every session_start record opens a new session, so one file holds any
+ * number of sessions; parse() decodes the selected one and counts them all.
+ */
+class session_log {
+public:
+    static constexpr std::uint8_t format_version = 1;
+    static constexpr int last_session = -1;
+
+    session_header header;
+    std::vector<session_slot_setup> slot_setups;
+    std::vector<session_event> events;
+    int sessions_count = 0;
+
+    bool parse(
+        const std::vector<std::uint8_t>& bytes, int session = last_session
+    );
+    bool read_from(const std::string& path, int session = last_session);
+    std::int64_t duration_ms() const;
+};
+
+/**
+ * @brief Encodes a running session into the session_log format.
+ *
+ * The table advances the recorder's clock from its own ticks; events are
+ * stamped with the last time set. save() appends the session's records to
+ * the file, writing the header first when the file is new or not a session
+ * log, and then drops them, so every session is written exactly once.
+ */
+class session_recorder {
+public:
+    explicit session_recorder(std::string path);
+
+    void begin_session(const session_header& header);
+    void add_slot(const session_slot_setup& setup);
+    void set_time(std::int64_t time_ms);
+    void record(
+        session_event_kind kind, int slot, int value = 0, int expected = 0,
+        bool flag = false
+    );
+    bool save();
+
+    bool is_recording() const;
+    const std::string& path() const;
+    const std::vector<std::uint8_t>& bytes() const;
+
+private:
+    void write_record_start(session_event_kind kind);
+
+    std::string file_path;
+    std::vector<std::uint8_t> buffer;
+    std::int64_t current_time_ms;
+    std::int64_t last_record_ms;
+    bool recording;
+};
+
+#endif // KCUCKOUNTER_HELPERS_SESSION_LOG_HPP
@@ -0,0 +1,39 @@
+#ifndef KCUCKOUNTER_HELPERS_SESSION_REPLAY_HPP
+#define KCUCKOUNTER_HELPERS_SESSION_REPLAY_HPP
+
+#include "helpers/session_log.hpp"
+#include <cstdint>
+
+struct session_replay_result {
+    int events = 0;
+    int picks = 0;
+    int mismatched_picks = 0;
+    int answers = 0;
+    int correct_answers = 0;
+    int mismatched_answers = 0;
+    std::int64_t session_ms = 0;
+    std::int64_t replay_us = 0;
+
+    bool matches() const;
+};
+
+/**
+ * @brief Re-deals a recorded session without any widgets.
+ *
+ * Every slot gets a slot_model reseeded and started exactly like the table
+ * does, with the recorded weights. Recorded picks and quiz checks are
+ * compared against the re-dealt shoes and the models' own checkpoints, so
+ * a clean run proves the session is reproducible from its seed and inputs
+ * alone.
+ */
+class session_replay {
+public:
+    explicit session_replay(const session_log& recorded);
+
+    session_replay_result run() const;
+
+private:
+    const session_log& log;
+};
+
+#endif // KCUCKOUNTER_HELPERS_SESSION_REPLAY_HPP
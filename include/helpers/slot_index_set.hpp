@@ -0,0 +1,37 @@
+#ifndef KCUCKOUNTER_HELPERS_SLOT_INDEX_SET_HPP
+#define KCUCKOUNTER_HELPERS_SLOT_INDEX_SET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Indexed sparse set of slot indices in [0, capacity).
+ *
+ * Members live unordered in a dense array with a position lookup per index,
+ * so insert, erase, contains and picking the n-th member are constant time
+ * and never allocate after resize(). A parallel bit mask answers the next
+ * member at or after an index, in index order, one 64-slot word at a time.
+ */
+class slot_index_set {
+public:
+    slot_index_set();
+
+    void resize(int capacity);
+    void clear();
+    void insert(int index);
+    void erase(int index);
+    void assign(int index, bool member);
+    bool contains(int index) const;
+    bool empty() const;
+    int size() const;
+    int at(int position) const;
+    int next_from(int index) const;
+
+private:
+    std::vector<int> members;
+    std::vector<int> positions;
+    std::vector<std::uint64_t> mask;
+};
+
+#endif // KCUCKOUNTER_HELPERS_SLOT_INDEX_SET_HPP
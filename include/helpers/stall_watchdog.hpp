@@ -0,0 +1,73 @@
+#ifndef KCUCKOUNTER_HELPERS_STALL_WATCHDOG_HPP
+#define KCUCKOUNTER_HELPERS_STALL_WATCHDOG_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct stall_zone_count {
+    std::string zone;
+    int stalls = 0;
+    std::int64_t worst_ms = 0;
+};
+
+/**
+ * @brief Background thread that detects stalls of the GUI event loop.
+ *
+ * The GUI thread calls heartbeat() from a short repeating timer and is the
+ * thread that called trace_recorder::track_zones(). The watchdog polls the
+ * time since the last heartbeat; once it exceeds the threshold, the zone
+ * then active on the GUI thread is blamed. When heartbeats resume the
+ * stall is counted for that zone, the event_loop_stalls counter is raised,
+ * a "stall" zone is added to the trace and, if a log file was given, one
+ * line is appended to it. Nothing runs until start(): main() starts it for
+ * --stall-log and --trace, the performance HUD while it is shown.
+ */
+class stall_watchdog {
+public:
+    static constexpr std::int64_t default_threshold_ms = 100;
+
+    static stall_watchdog& instance();
+    ~stall_watchdog();
+
+    stall_watchdog(const stall_watchdog&) = delete;
+    stall_watchdog& operator=(const stall_watchdog&) = delete;
+
+    void start(
+        std::int64_t threshold_ms = default_threshold_ms,
+        const std::string& log_path = std::string()
+    );
+    void stop();
+    bool is_running() const;
+    void heartbeat();
+
+    std::int64_t threshold_ms() const;
+    int stall_count() const;
+    std::vector<stall_zone_count> stalls_by_zone() const;
+
+private:
+    stall_watchdog();
+
+    void run();
+    void finish_stall(std::int64_t end_us);
+
+    std::atomic<std::int64_t> last_heartbeat_us;
+    std::int64_t threshold_us;
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::vector<stall_zone_count> zones;
+    int total_stalls;
+    std::ofstream log;
+    bool in_stall;
+    const char* stall_zone;
+    std::int64_t stall_start_us;
+};
+
+#endif // KCUCKOUNTER_HELPERS_STALL_WATCHDOG_HPP
@@ -0,0 +1,101 @@
+#ifndef KCUCKOUNTER_HELPERS_STARTUP_BOOTSTRAP_HPP
+#define KCUCKOUNTER_HELPERS_STARTUP_BOOTSTRAP_HPP
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+class QWidget;
+
+/**
+ * @brief Dependency-ordered application startup with per-stage timing.
+ *
+ * Each stage names the stages it waits for and starts once all of them have
+ * finished, either on the thread pool or on the GUI thread. GUI stages are
+ * queued to the event loop rather than run inline, so a window shown by one
+ * stage gets to paint before the next GUI stage begins. A deferred stage
+ * gets a callback and finishes when it calls it, which lets a stage wait
+ * for asynchronous work such as rasterization.
+ *
+ * Times are milliseconds of a monotonic clock started at construction;
+ * main() creates the bootstrap first, so they include QApplication setup.
+ * watch_first_frame() records the first paint of a window as the
+ * @c first_frame milestone, and the moment the last stage finishes is
+ * reported as time-to-playable.
+ */
+class startup_bootstrap : public QObject {
+    Q_OBJECT
+
+public:
+    enum class stage_thread { gui, pool };
+
+    struct stage_timing {
+        QString name;
+        stage_thread thread;
+        qint64 ready_ms;
+        qint64 start_ms;
+        qint64 finish_ms;
+    };
+
+    explicit startup_bootstrap(QObject* parent = nullptr);
+    ~startup_bootstrap() override;
+
+    void add_stage(
+        const QString& name, const QStringList& dependencies,
+        stage_thread thread, std::function<void()> work
+    );
+    void add_deferred_stage(
+        const QString& name, const QStringList& dependencies,
+        std::function<void(std::function<void()> done)> work
+    );
+    void start();
+
+    void watch_first_frame(QWidget* window);
+    void mark(const QString& milestone);
+    qint64 milestone_ms(const QString& milestone) const;
+    qint64 elapsed_ms() const;
+
+    bool is_finished() const;
+    qint64 playable_ms() const;
+    const QVector<stage_timing>& timings() const;
+    QString report() const;
+
+signals:
+    void stage_finished(const QString& name);
+    void finished();
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    struct stage {
+        QString name;
+        QStringList dependencies;
+        stage_thread thread;
+        std::function<void(std::function<void()> done)> work;
+        qint64 ready_ms;
+        qint64 start_ms;
+        bool started;
+        bool done;
+    };
+
+    void launch_ready_stages();
+    bool dependencies_done(const stage& entry) const;
+    void run_stage(int index);
+    void finish_stage(int index);
+
+    QElapsedTimer clock;
+    QVector<stage> stages;
+    QHash<QString, int> stage_index;
+    QHash<QString, qint64> milestones;
+    QVector<stage_timing> finished_stages;
+    QWidget* first_frame_window;
+    bool running;
+    qint64 playable_at_ms;
+};
+
+#endif // KCUCKOUNTER_HELPERS_STARTUP_BOOTSTRAP_HPP
@@ -1,10 +1,17 @@
 #ifndef KCUCKOUNTER_HELPERS_STRATEGY_DATA_HPP
 #define KCUCKOUNTER_HELPERS_STRATEGY_DATA_HPP
 
+#include "card_helpers/strategy_matrix.hpp"
+
+#include <QByteArray>
+#include <QHash>
 #include <QMap>
 #include <QString>
 #include <QStringList>
 #include <QVector>
+#include <memory>
+
+class QJsonObject;
 
 struct strategy_data {
     int id = 0;
@@ -26,11 +33,67 @@ struct strategy_data {
         QString citation;
         QString url;
         QString accessed;
+
+        bool operator==(const strategy_reference& other) const = default;
     };
 
     QVector<strategy_reference> references;
+
+    bool operator==(const strategy_data& other) const = default;
+};
+
+/**
+ * @brief Immutable, indexed set of strategies.
+ *
+ * The bundled strategies are compiled into constexpr tables from
+ * assets/strategies.json at build time (see cmake/strategy_table.cmake), so
+ * instance() only reads the optional user strategies file, which uses the same
+ * JSON schema. load() builds that registry without installing it and touches no
+ * shared state, so startup can run it on a worker thread. User entries whose
+ * id, name or slug collide with an existing strategy are skipped.
+ * strategy_watcher swaps in a new registry when that file changes; holders of
+ * the old snapshot keep a consistent view until they ask instance() again.
+ * Lookups by name, slug or id are hash lookups. weight_matrix() holds every
+ * strategy's weights in registry order for evaluating all counts of one shoe at
+ * once. Weights are handed out as implicitly shared QVector copies, so callers
+ * get a view of the registry's data without allocating.
+ */
+class strategy_registry {
+public:
+    static std::shared_ptr<const strategy_registry> instance();
+    static std::shared_ptr<const strategy_registry> load();
+    static std::shared_ptr<const strategy_registry>
+    from_json(const QByteArray& json);
+    static std::shared_ptr<const strategy_registry>
+    with_user_strategies(const QByteArray& json);
+    static std::shared_ptr<const strategy_registry>
+    with_user_strategies(const QVector<strategy_data>& user_strategies);
+    static void set_instance(std::shared_ptr<const strategy_registry> registry);
+    static QString user_strategies_path();
+
+    const QVector<strategy_data>& strategies() const;
+    const QMap<QString, QString>& key_descriptions() const;
+    const strategy_data* find_by_name(const QString& name) const;
+    const strategy_data* find_by_slug(const QString& slug) const;
+    const strategy_data* find_by_id(int id) const;
+    QVector<int> weights_for_name(const QString& name) const;
+    const strategy_matrix& weight_matrix() const;
+    QStringList changed_strategy_names(const strategy_registry& other) const;
+
+private:
+    strategy_registry(
+        QVector<strategy_data> strategies, QMap<QString, QString> descriptions
+    );
+
+    QVector<strategy_data> entries;
+    QMap<QString, QString> descriptions;
+    QHash<QString, int> name_index;
+    QHash<QString, int> slug_index;
+    QHash<int, int> id_index;
+    strategy_matrix matrix;
 };
 
+bool parse_strategy(const QJsonObject& object, strategy_data& data);
 QVector<strategy_data> load_strategies();
 QMap<QString, QString> load_strategy_key_descriptions();
 
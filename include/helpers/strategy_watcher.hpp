@@ -0,0 +1,57 @@
+#ifndef KCUCKOUNTER_HELPERS_STRATEGY_WATCHER_HPP
+#define KCUCKOUNTER_HELPERS_STRATEGY_WATCHER_HPP
+
+#include "helpers/strategy_data.hpp"
+#include "helpers/time_interface.hpp"
+
+#include <QByteArray>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Reloads the user strategies file while the application runs.
+ *
+ * Both the file and its directory are watched, so editors that save by
+ * replacing the file are picked up too. Changes are debounced; a reload
+ * re-parses only the strategy objects whose JSON differs from the last
+ * version and reuses the parsed data of the others. The new registry is
+ * diffed against the current one and, when anything changed, installed
+ * with strategy_registry::set_instance() before strategies_changed() lists
+ * the added, removed and modified strategy names. A file that does not
+ * parse is ignored, so a half-written save keeps the previous strategies.
+ */
+class strategy_watcher : public QObject {
+    Q_OBJECT
+
+public:
+    explicit strategy_watcher(
+        QString path = strategy_registry::user_strategies_path(),
+        QObject* parent = nullptr
+    );
+
+    const QString& path() const;
+    void reload();
+
+signals:
+    void strategies_changed(const QStringList& changed_names);
+
+private:
+    struct parsed_strategy {
+        QJsonObject source;
+        strategy_data data;
+    };
+
+    void watch_paths();
+
+    QString file_path;
+    QFileSystemWatcher watcher;
+    time_interface reload_timer;
+    QByteArray last_contents;
+    QHash<QString, parsed_strategy> parsed_cache;
+};
+
+#endif // KCUCKOUNTER_HELPERS_STRATEGY_WATCHER_HPP
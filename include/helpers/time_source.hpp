@@ -0,0 +1,102 @@
+#ifndef KCUCKOUNTER_HELPERS_TIME_SOURCE_HPP
+#define KCUCKOUNTER_HELPERS_TIME_SOURCE_HPP
+
+#include <QObject>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Monotonic clock and timer factory behind every game timer.
+ *
+ * Clocks capture instance() when they are constructed, so swapping in a
+ * virtual_time_source before building a table makes the whole session run
+ * on virtual time.
+ */
+class time_source {
+public:
+    class timer {
+    public:
+        virtual ~timer() = default;
+
+        virtual void set_interval(int interval_ms) = 0;
+        virtual int interval() const = 0;
+        virtual void set_single_shot(bool single_shot) = 0;
+        virtual void set_precise(bool precise) = 0;
+        virtual void start() = 0;
+        virtual void stop() = 0;
+        virtual bool is_active() const = 0;
+    };
+
+    virtual ~time_source() = default;
+
+    virtual std::int64_t now_ns() const = 0;
+    virtual std::unique_ptr<timer>
+    create_timer(std::function<void()> callback) = 0;
+    virtual void single_shot(
+        int interval_ms, QObject* context, std::function<void()> handler
+    ) = 0;
+
+    static std::shared_ptr<time_source> instance();
+    static void set_instance(std::shared_ptr<time_source> source);
+};
+
+/**
+ * @brief Wall-clock time backed by QElapsedTimer and QTimer.
+ */
+class system_time_source : public time_source {
+public:
+    system_time_source();
+    ~system_time_source() override;
+
+    std::int64_t now_ns() const override;
+    std::unique_ptr<timer>
+    create_timer(std::function<void()> callback) override;
+    void single_shot(
+        int interval_ms, QObject* context, std::function<void()> handler
+    ) override;
+
+private:
+    struct system_clock_state;
+    std::unique_ptr<system_clock_state> state;
+};
+
+/**
+ * @brief Manually advanced time for deterministic, accelerated runs.
+ *
+ * Time only moves in advance_ms() and run_next(); due timers fire in
+ * deadline order at their exact virtual deadlines, with no event loop and
+ * no sleeping, so a long session replays as fast as its handlers run.
+ */
+class virtual_time_source : public time_source {
+public:
+    virtual_time_source();
+    ~virtual_time_source() override;
+
+    std::int64_t now_ns() const override;
+    std::unique_ptr<timer>
+    create_timer(std::function<void()> callback) override;
+    void single_shot(
+        int interval_ms, QObject* context, std::function<void()> handler
+    ) override;
+
+    void advance_ms(std::int64_t delta_ms);
+    bool run_next();
+    std::size_t pending_timers() const;
+
+private:
+    class virtual_timer;
+
+    std::int64_t current_ns;
+    std::uint64_t next_sequence;
+    std::vector<virtual_timer*> timers;
+    std::vector<std::unique_ptr<timer>> single_shots;
+
+    virtual_timer* next_due(std::int64_t limit_ns) const;
+    void fire(virtual_timer* due);
+    void release_single_shot(const timer* fired);
+};
+
+#endif // KCUCKOUNTER_HELPERS_TIME_SOURCE_HPP
@@ -0,0 +1,139 @@
+#ifndef KCUCKOUNTER_HELPERS_TRACE_RECORDER_HPP
+#define KCUCKOUNTER_HELPERS_TRACE_RECORDER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Live performance counters shared by traces and the HUD.
+ *
+ * deal_jitter_us holds the largest deal timer lateness since it was last
+ * taken; the others are running totals. The *_bytes counters account the
+ * memory held per subsystem (see memory_report.hpp).
+ */
+enum class trace_counter : std::uint8_t {
+    raster_jobs_pending,
+    raster_jobs_active,
+    card_raster_bytes,
+    scaled_face_bytes,
+    marking_cache_bytes,
+    preview_cache_bytes,
+    slot_widget_bytes,
+    deal_jitter_us,
+    event_loop_stalls
+};
+
+/**
+ * @brief Process-wide collector of Chrome trace events.
+ *
+ * Disabled by default, in which case a trace_zone costs one relaxed atomic
+ * load, plus a thread_local check and, on the thread that called
+ * track_zones(), an atomic exchange and store of the active zone. Once
+ * enabled, every finished zone is stored as a complete ("X") event stamped
+ * with a small per-thread id; write_to() saves them as Chrome trace-event
+ * JSON, which Perfetto and chrome://tracing open directly. Event names and
+ * categories must be string literals: only the pointers are kept, so
+ * recording does not allocate beyond the event buffer, which stops growing
+ * at max_events.
+ *
+ * The trace_counter values are kept whether or not tracing is enabled,
+ * together with the highest value each has reached; while tracing is
+ * enabled, every change is also recorded as a counter ("C") event.
+ * Likewise, the innermost zone of the thread that called track_zones() is
+ * always published as active_zone(), so stall_watchdog can tell what the
+ * GUI thread was doing when it stopped responding.
+ */
+class trace_recorder {
+public:
+    static constexpr std::size_t max_events = 1 << 20;
+    static constexpr std::size_t counters_count = 9;
+
+    static trace_recorder& instance();
+
+    void enable();
+    void disable();
+    bool is_enabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t now_us() const;
+    void add_complete(
+        const char* name, const char* category, std::int64_t start_us,
+        std::int64_t duration_us
+    );
+    void add_instant(const char* name, const char* category);
+
+    void add_to_counter(trace_counter counter, std::int64_t delta);
+    void raise_counter(trace_counter counter, std::int64_t value);
+    std::int64_t counter(trace_counter counter) const;
+    std::int64_t counter_peak(trace_counter counter) const;
+    std::int64_t take_counter(trace_counter counter);
+
+    void track_zones();
+    const char* active_zone() const;
+
+    std::size_t event_count() const;
+    void clear();
+    std::string to_json() const;
+    bool write_to(const std::string& path) const;
+
+private:
+    struct trace_event {
+        const char* name;
+        const char* category;
+        char phase;
+        std::int64_t start_us;
+        std::int64_t duration_us; // The value of counter events.
+        std::uint32_t thread;
+    };
+
+    trace_recorder();
+
+    static std::uint32_t current_thread();
+    static const char* counter_name(trace_counter counter);
+    static bool is_tracked_thread();
+    static void raise_to(std::atomic<std::int64_t>& value, std::int64_t to);
+    const char* enter_zone(const char* name);
+    void leave_zone(const char* previous);
+    void append(const trace_event& event);
+    void record_counter(trace_counter counter, std::int64_t value);
+
+    std::atomic<bool> enabled;
+    std::chrono::steady_clock::time_point origin;
+    mutable std::mutex mutex;
+    std::vector<trace_event> events;
+    std::array<std::atomic<std::int64_t>, counters_count> counters;
+    std::array<std::atomic<std::int64_t>, counters_count> peaks;
+    std::atomic<const char*> tracked_zone;
+
+    friend class trace_zone;
+};
+
+/**
+ * @brief Records the lifetime of a scope as one trace event.
+ *
+ * Does not read the clock while the recorder is disabled; on the tracked
+ * thread it still updates trace_recorder::active_zone().
+ */
+class trace_zone {
+public:
+    explicit trace_zone(const char* name, const char* category = "app");
+    ~trace_zone();
+
+    trace_zone(const trace_zone&) = delete;
+    trace_zone& operator=(const trace_zone&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    const char* previous_zone;
+    std::int64_t start_us;
+};
+
+#endif // KCUCKOUNTER_HELPERS_TRACE_RECORDER_HPP
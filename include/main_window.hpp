@@ -2,12 +2,17 @@
 #define KCUCKOUNTER_MAIN_WINDOW_HPP
 
 #include "helpers/widget_helpers.hpp"
+#include <functional>
+#include <memory>
 
 class table;
+class strategy_watcher;
+class session_log;
 class QLabel;
 class QDialog;
 class QProgressBar;
 class QSlider;
+class settings_template_widget;
 
 class main_window : public BaseMainWindow {
     Q_OBJECT
@@ -16,6 +21,11 @@ public:
     explicit main_window(BaseWidget* parent = nullptr);
     ~main_window() override;
 
+    void populate_table();
+    void prepare_initial_cards(std::function<void()> ready);
+    void record_sessions_to(const QString& path);
+    void start_replay(std::shared_ptr<const session_log> log);
+
 private slots:
     void on_continue_button_clicked();
     void on_new_game_triggered();
@@ -29,10 +39,15 @@ private:
     BaseCheckBox* wait_for_answers;
     BaseCheckBox* allow_skipping;
     BaseComboBox* dealing_mode;
+    BaseComboBox* late_picks;
     BasePushButton* continue_button;
     table* table_widget;
+    strategy_watcher* strategies_watcher;
     QDialog* setup_dialog;
     BaseWidget* setup_widget;
+    QDialog* settings_dialog;
+    settings_template_widget* appearance_settings;
+    bool settings_dialog_stale;
     BaseClock* clock_timer;
     QLabel* clock_label;
     QLabel* status_label;
@@ -50,13 +65,17 @@ private:
     bool pending_start_after_rasterization;
     int score_correct;
     int score_total;
+    std::shared_ptr<const session_log> pending_replay;
 
     void setup_ui();
     void update_status_text();
     void reset_game_state(bool show_setup_dialog, bool mark_finished = false);
     void show_game_over_dialog();
+    void show_memory_report();
     void start_quiz_from_ui();
     void pause_for_dialog();
+    void build_settings_dialog();
+    void discard_settings_dialog();
 };
 
 #endif // KCUCKOUNTER_MAIN_WINDOW_HPP
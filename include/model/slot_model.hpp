@@ -0,0 +1,89 @@
+#ifndef KCUCKOUNTER_MODEL_SLOT_MODEL_HPP
+#define KCUCKOUNTER_MODEL_SLOT_MODEL_HPP
+
+#include "card_helpers/card_picker.hpp"
+#include "card_helpers/rank_counter.hpp"
+#include "helpers/random_generator.hpp"
+#include <QVector>
+#include <array>
+#include <memory>
+
+struct slot_score {
+    int correct = 0;
+    int total = 0;
+};
+
+/**
+ * @brief Game state of one table slot, without any widget.
+ *
+ * Owns the slot's shoe handle, the running count for its strategy and the
+ * quiz checkpoint: after every checkpoint_interval-th card a prompt opens
+ * and blocks dealing until it is answered correctly or continued. Outside
+ * training an opened prompt counts as a question, a correct answer scores
+ * it, a skip withdraws it and a wrong answer exhausts the shoe.
+ */
+class slot_model {
+public:
+    static constexpr int default_checkpoint_interval = 30;
+
+    enum class answer_outcome { ignored, correct, wrong, exhausted, skipped };
+
+    slot_model();
+    explicit slot_model(std::shared_ptr<shoe_bank> bank);
+
+    slot_model(const slot_model&) = delete;
+    slot_model& operator=(const slot_model&) = delete;
+
+    static int cards_for_quiz_type(int quiz_type_index);
+
+    void attach(std::shared_ptr<shoe_bank> bank);
+    void reseed(const random_generator& generator);
+    void start(int cards_per_deck, int decks_count, bool infinity_enabled);
+    void clear();
+    void set_infinity(bool enabled);
+    void set_training(bool enabled);
+    void set_paused(bool paused);
+    void set_weights(const QVector<int>& weights);
+    void set_checkpoint_interval(int cards);
+
+    bool deal();
+    answer_outcome submit_answer(int provided);
+    answer_outcome skip_question();
+    bool continue_quiz();
+    void mark_exhausted();
+
+    bool can_deal() const;
+    bool is_paused() const;
+    bool is_prompt_active() const;
+    bool is_exhausted() const;
+    bool is_pickable() const;
+    bool is_training() const;
+    bool is_infinity() const;
+    bool has_cards() const;
+    int cards_per_deck() const;
+    int decks_count() const;
+    int current_card_index() const;
+    int current_position() const;
+    int running_count() const;
+    const QVector<int>& weights() const;
+    const std::array<int, rank_counter::ranks_count>& seen_rank_counts() const;
+    const card_picker& picker() const;
+    const slot_score& score() const;
+
+private:
+    card_picker shoe;
+    rank_counter counter;
+    QVector<int> strategy_weights;
+    slot_score current_score;
+    int deck_cards;
+    int decks;
+    int checkpoint_interval;
+    bool infinity_enabled;
+    bool training_enabled;
+    bool paused;
+    bool prompt_active;
+
+    void open_prompt();
+};
+
+#endif // KCUCKOUNTER_MODEL_SLOT_MODEL_HPP
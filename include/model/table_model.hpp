@@ -0,0 +1,65 @@
+#ifndef KCUCKOUNTER_MODEL_TABLE_MODEL_HPP
+#define KCUCKOUNTER_MODEL_TABLE_MODEL_HPP
+
+#include "helpers/random_generator.hpp"
+#include "helpers/slot_index_set.hpp"
+#include "model/slot_model.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class shoe_bank;
+
+/**
+ * @brief Headless table: slot models on one shoe bank and slot selection.
+ *
+ * Decides which slots receive the next card for the dealing mode, keeps
+ * the live (shoe not exhausted) and pickable (live and not waiting on a
+ * prompt) slot sets and reports game over. Views that change a slot
+ * directly call refresh_slot() afterwards; deal_next() refreshes on its
+ * own, so a headless run needs nothing but this class.
+ */
+class table_model {
+public:
+    enum class dealing_mode { sequential, random, simultaneous };
+
+    table_model();
+
+    table_model(const table_model&) = delete;
+    table_model& operator=(const table_model&) = delete;
+
+    void set_slot_count(int count);
+    int slot_count() const;
+    slot_model& slot(int index);
+    const slot_model& slot(int index) const;
+    const std::shared_ptr<slot_model>& slot_handle(int index) const;
+    void swap_slots(int first, int second);
+
+    void set_dealing_mode(dealing_mode mode);
+    dealing_mode mode() const;
+
+    void start(std::uint64_t seed);
+    void start_slots(
+        std::uint64_t seed, int cards_per_deck, int decks_count,
+        bool infinity_enabled
+    );
+    void refresh_slot(int index);
+    void refresh_slots();
+
+    const std::vector<int>& select_next();
+    const std::vector<int>& deal_next();
+    bool is_game_over() const;
+    slot_score total_score() const;
+
+private:
+    std::shared_ptr<shoe_bank> shoes;
+    std::vector<std::shared_ptr<slot_model>> slot_states;
+    dealing_mode current_mode;
+    random_generator selection_gen;
+    int next_slot_index;
+    slot_index_set live_slots;
+    slot_index_set pickable_slots;
+    std::vector<int> selected;
+};
+
+#endif // KCUCKOUNTER_MODEL_TABLE_MODEL_HPP
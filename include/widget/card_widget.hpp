@@ -1,11 +1,11 @@
 #ifndef KCUCKOUNTER_WIDGETS_CARD_WIDGET_HPP
 #define KCUCKOUNTER_WIDGETS_CARD_WIDGET_HPP
 
-#include "card_helpers/card_picker.hpp"
 #include "helpers/image_cacher.hpp"
+#include "helpers/memory_report.hpp"
 #include "helpers/random_generator.hpp"
-#include "helpers/time_interface.hpp"
 #include "helpers/widget_helpers.hpp"
+#include "model/slot_model.hpp"
 #include <QFutureWatcher>
 #include <QImage>
 #include <QPixmap>
@@ -13,6 +13,7 @@
 #include <QString>
 #include <QSvgRenderer>
 #include <QVector>
+#include <cstdint>
 #include <deque>
 #include <memory>
 
@@ -39,6 +40,11 @@ public:
     void
     start_quiz(int quiz_type_index, int decks_count, bool infinity_enabled);
     void set_infinity(bool enabled);
+    void reseed_random(std::uint64_t seed, std::uint64_t stream);
+    void set_shoe_bank(std::shared_ptr<shoe_bank> bank);
+    void set_model(std::shared_ptr<slot_model> model);
+    slot_model& model();
+    const slot_model& model() const;
     void set_running(bool running);
     void set_slot_rotated(bool rotated);
     void set_show_card_indexing(bool enabled);
@@ -54,36 +60,36 @@ public:
     bool is_deck_exhausted() const;
     void mark_deck_exhausted();
     int current_position() const;
+    int current_card_index() const;
     int current_total_weight() const;
+    int cards_in_deck() const;
+    const QVector<int>& strategy_weight_values() const;
+    const std::array<int, rank_counter::ranks_count>& seen_rank_counts() const;
     void clear_quiz();
     void trigger_highlight(int duration_ms);
-    void tick_highlight(int delta_ms);
+    bool advance_animations(int delta_ms, bool highlights_running);
+    bool is_animating(bool highlights_running) const;
     void prepare_card_faces();
+    qint64 raster_cache_bytes() const;
 
 signals:
     void rasterization_busy_changed(bool busy);
+    void animation_started();
 
 protected:
     void paintEvent(QPaintEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
 
 private:
-    bool running;
+    std::shared_ptr<slot_model> model_internal;
     bool swap_selected_flag;
-    card_picker picker;
     random_generator random_gen;
     qreal card_rotation_deg;
     QPointF card_offset;
     bool slot_rotated;
     bool show_card_indexing_flag;
     bool show_strategy_name_flag;
-    bool training_mode_flag;
     QString strategy_name;
-    QVector<int> strategy_weights;
-    int cards_per_deck;
-    int decks_count;
-    bool infinity_enabled;
-    std::unique_ptr<time_interface> selection_timer;
     qreal selection_phase;
 
     struct discard_card {
@@ -108,6 +114,9 @@ private:
     QSize raster_task_size;
     QSize pending_raster_size;
     bool rasterizing;
+    memory_account raster_memory;
+    memory_account face_memory;
+    memory_account slot_memory;
 
     void update_card_jitter();
     void update_table_marking();
@@ -116,14 +125,14 @@ private:
     void update_card_faces(const QSize& target_size);
     void record_discard();
     qreal highlight_strength() const;
-    void update_selection_pulse();
-    int total_weight_for_picks() const;
+    void advance_selection_pulse(int delta_ms);
     void start_rasterization(const QSize& target_size);
     void apply_rasterized_images(
         const QVector<QImage>& images, const QSize& target_size
     );
     void set_rasterizing(bool active);
     void on_rasterization_finished();
+    void report_memory();
 };
 
 #endif // KCUCKOUNTER_WIDGETS_CARD_WIDGET_HPP
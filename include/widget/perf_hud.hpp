@@ -0,0 +1,63 @@
+#ifndef KCUCKOUNTER_WIDGET_PERF_HUD_HPP
+#define KCUCKOUNTER_WIDGET_PERF_HUD_HPP
+
+#include "helpers/time_interface.hpp"
+#include "helpers/widget_helpers.hpp"
+
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QStringList>
+
+class QEvent;
+class QHideEvent;
+class QPaintEvent;
+class QShowEvent;
+class table;
+
+/**
+ * @brief Performance overlay shown in the corner of the table.
+ *
+ * Frames are the update requests of the table's top-level window; the HUD
+ * times each one as it is handled, so the frame time includes painting and
+ * flushing every widget. Every sample_interval_ms it reads the
+ * trace_recorder counters (raster jobs, deal timer lateness), the memory
+ * held per subsystem, the per-slot card cache sizes and the
+ * stall_watchdog's stalls per zone. It only watches and samples while
+ * visible; unless --stall-log or --trace already started the watchdog, the
+ * HUD runs it, and feeds its heartbeat, for as long as it is shown.
+ */
+class perf_hud : public BaseWidget {
+    Q_OBJECT
+
+public:
+    static constexpr int sample_interval_ms = 500;
+    static constexpr int listed_stall_zones = 3;
+
+    explicit perf_hud(table* owner);
+    ~perf_hud() override;
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    void sample();
+    void watch_window(QWidget* window);
+    void release_watchdog();
+
+    table* owner;
+    time_interface sample_timer;
+    time_interface heartbeat_timer;
+    bool owns_watchdog;
+    QElapsedTimer clock;
+    QPointer<QWidget> watched_window;
+    bool in_frame;
+    qint64 last_sample_ms;
+    int frames;
+    qint64 worst_frame_us;
+    QStringList lines;
+};
+
+#endif // KCUCKOUNTER_WIDGET_PERF_HUD_HPP
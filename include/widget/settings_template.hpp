@@ -2,9 +2,15 @@
 #define KCUCKOUNTER_WIDGET_SETTINGS_TEMPLATE_HPP
 
 #include "helpers/strategy_data.hpp"
+#include "helpers/strategy_simulator.hpp"
+#include "helpers/time_interface.hpp"
 #include "helpers/widget_helpers.hpp"
+#include "widget/strategy_details_model.hpp"
 
+#include <QFutureWatcher>
+#include <QHash>
 #include <QObject>
+#include <memory>
 
 class settings_shared_state : public QObject {
     Q_OBJECT
@@ -29,13 +35,22 @@ private:
 
 class QLabel;
 class QListWidget;
+class QShowEvent;
 class QButtonGroup;
 class card_preview_carousel;
-class QTableWidget;
+class QTableView;
 class table;
 
 enum class settings_tab_kind { appearance, strategies };
 
+/**
+ * @brief One Settings / Strategy details page, built on first show.
+ *
+ * The constructor only records its arguments; the page's widgets, tables
+ * and card previews are created by ensure_ui(), which the first showEvent()
+ * calls. Hidden tabs therefore cost nothing until they are opened, and a
+ * page kept alive between openings is built once.
+ */
 class settings_template_widget : public BaseWidget {
     Q_OBJECT
 
@@ -47,9 +62,13 @@ public:
         settings_shared_state* shared_state = nullptr
     );
     ~settings_template_widget() override;
+    void ensure_ui();
     void apply_theme_settings();
     void reset_theme_selection();
 
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private:
     void setup_ui(const QString& selected_strategy);
     void setup_strategy_ui(const QString& selected_strategy);
@@ -59,8 +78,13 @@ private:
     void update_theme_palette_preview(int index);
     void update_weights_carousel(int suit_index);
     void update_suit_selection(int index);
+    void start_metrics_simulation();
+    void update_simulation_progress();
+    void finish_metrics_simulation();
 
     settings_tab_kind tab_kind;
+    bool ui_built;
+    QString initial_strategy;
     table* table_widget;
     settings_shared_state* shared_state;
     QVector<strategy_data> strategies;
@@ -72,8 +96,17 @@ private:
     QLabel* references_title_label;
     QLabel* references_label;
     card_preview_carousel* weights_carousel;
-    QTableWidget* general_table;
-    QTableWidget* metrics_table;
+    strategy_details_model* general_model;
+    strategy_details_model* metrics_model;
+    QTableView* general_table;
+    QTableView* metrics_table;
+    QVector<strategy_details_text> details_text;
+    BasePushButton* simulate_button;
+    QFutureWatcher<strategy_metrics> simulation_watcher;
+    std::shared_ptr<strategy_simulator> simulator;
+    time_interface simulation_progress_timer;
+    int simulated_strategy_id;
+    QHash<int, strategy_metrics> simulated_metrics;
     BaseComboBox* suit_combo_box;
     BaseComboBox* theme_combo_box;
     BaseComboBox* orientation_combo_box;
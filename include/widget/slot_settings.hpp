@@ -13,6 +13,7 @@ public:
     ~slot_settings() override;
 
     static QSize minimum_settings_size();
+    static void fill_strategy_names(BaseComboBox* combo_box);
 
     BaseCheckBox* infinity_check_box() const;
     BaseSpinBox* deck_count_spin_box() const;
@@ -0,0 +1,54 @@
+#ifndef KCUCKOUNTER_WIDGET_STRATEGY_DETAILS_MODEL_HPP
+#define KCUCKOUNTER_WIDGET_STRATEGY_DETAILS_MODEL_HPP
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Preformatted detail text of one strategy.
+ *
+ * Built once per strategy when the details page opens, so switching the
+ * selection only swaps implicitly shared strings.
+ */
+struct strategy_details_text {
+    QStringList general_values;
+    QStringList metric_values;
+    QString notes_html;
+    QString references_html;
+};
+
+/**
+ * @brief Read-only two-column table of field labels and strategy values.
+ *
+ * The label column is fixed at construction; set_values() replaces the
+ * value column and reports it with a single dataChanged().
+ */
+class strategy_details_model : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    strategy_details_model(
+        const QString& title, const QStringList& labels,
+        QObject* parent = nullptr
+    );
+
+    void set_values(const QStringList& next_values);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant
+    data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(
+        int section, Qt::Orientation orientation,
+        int role = Qt::DisplayRole
+    ) const override;
+
+private:
+    QString title;
+    QString value_title;
+    QStringList labels;
+    QStringList values;
+};
+
+#endif // KCUCKOUNTER_WIDGET_STRATEGY_DETAILS_MODEL_HPP
@@ -1,11 +1,15 @@
 #ifndef KCUCKOUNTER_WIDGETS_TABLE_HPP
 #define KCUCKOUNTER_WIDGETS_TABLE_HPP
 
-#include "helpers/random_generator.hpp"
+#include "helpers/deal_scheduler.hpp"
+#include "helpers/frame_clock.hpp"
 #include "helpers/time_interface.hpp"
 #include "helpers/widget_helpers.hpp"
+#include "model/table_model.hpp"
 #include <QSet>
 #include <QSize>
+#include <QVector>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -14,6 +18,9 @@ class QPaintEvent;
 class QResizeEvent;
 class table_slot;
 class card_packer;
+class perf_hud;
+class session_log;
+class session_recorder;
 
 class table : public BaseWidget {
     Q_OBJECT
@@ -27,12 +34,23 @@ public:
     void clear_quiz();
     void set_paused(bool paused);
     void set_pick_interval(int interval_ms);
+    void set_catch_up_policy(catch_up_policy policy);
     void set_dealing_mode(int mode_index);
     void set_allow_skipping(bool allow);
     void schedule_card_preload();
     void prepare_cards_for_start();
     void apply_theme();
     bool is_rasterization_busy() const;
+    int pick_interval() const;
+    QVector<qint64> slot_cache_bytes() const;
+    void set_perf_hud_visible(bool visible);
+    bool is_perf_hud_visible() const;
+    std::uint64_t session_seed() const;
+    void set_session_recorder(std::shared_ptr<session_recorder> recorder);
+    void start_replay(const session_log& log);
+    bool is_replaying() const;
+    QString strategy_comparison_report() const;
+    void apply_strategy_changes(const QStringList& changed_names);
 
 public slots:
     void on_clock_tick(qint64 elapsed_ms, qint64 delta_ms);
@@ -54,26 +72,33 @@ private slots:
     void on_preload_tick();
 
 private:
-    enum class dealing_mode { sequential, random, simultaneous };
-
     std::vector<table_slot*> slot_widgets;
     table_slot* swap_source_slot;
     table_slot* copy_source_slot;
     std::unique_ptr<card_packer> card_packer_instance;
+    std::unique_ptr<table_model> model;
     int pick_interval_ms;
-    qint64 pick_elapsed_ms;
+    std::unique_ptr<deal_scheduler> pick_scheduler;
+    std::unique_ptr<frame_clock> animation_clock;
     bool quiz_running;
     bool quiz_paused;
     bool allow_skipping;
-    dealing_mode current_mode;
-    int next_slot_index;
     QSet<table_slot*> rasterizing_slots;
     bool rasterization_busy;
-    random_generator random_gen;
+    std::uint64_t session_index;
+    std::uint64_t session_seed_value;
+    std::shared_ptr<session_recorder> recorder;
+    std::unique_ptr<session_log> replay_log;
+    std::size_t replay_event_index;
     std::unique_ptr<time_interface> preload_timer;
+    perf_hud* hud;
     int rasterization_delay_ms() const;
     void update_layout();
     void on_pick_timeout();
+    void on_animation_frame(qint64 delta_ms);
+    void record_pick(int slot_index);
+    void finish_recording();
+    void advance_replay(qint64 elapsed_ms);
     void update_rasterization_state(table_slot* slot, bool busy);
     bool all_slots_exhausted() const;
     void handle_game_over();
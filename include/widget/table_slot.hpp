@@ -1,12 +1,22 @@
 #ifndef KCUCKOUNTER_WIDGETS_TABLE_SLOT_HPP
 #define KCUCKOUNTER_WIDGETS_TABLE_SLOT_HPP
 
+#include "card_helpers/rank_counter.hpp"
 #include "helpers/widget_helpers.hpp"
 
 #include <QBoxLayout>
 #include <QString>
+#include <QStringList>
+#include <array>
+#include <cstdint>
+#include <memory>
 
 class QStackedLayout;
+class shoe_bank;
+class slot_model;
+struct slot_score;
+class session_recorder;
+struct session_slot_setup;
 class QResizeEvent;
 class QLabel;
 class card_widget;
@@ -23,17 +33,33 @@ public:
     void set_rotated(bool rotated);
     void set_allow_skipping(bool allow);
 
+    void reseed_random(std::uint64_t seed, std::uint64_t stream);
+    void set_shoe_bank(std::shared_ptr<shoe_bank> bank);
+    void set_model(std::shared_ptr<slot_model> model);
     void start_quiz(int quiz_type_index);
+    void start_replay(int quiz_type_index, const session_slot_setup& setup);
+    void set_session_recorder(session_recorder* recorder, int slot_index);
+    void record_session_setup(std::uint64_t stream) const;
+    void submit_quiz_answer(int provided);
+    void skip_quiz_question(int provided);
+    void continue_quiz();
+    void set_infinity_enabled(bool enabled);
     void clear_quiz();
     void set_paused(bool paused);
     void advance_card();
     void trigger_highlight(int duration_ms);
-    void tick_highlight(int delta_ms);
+    bool advance_animations(int delta_ms, bool highlights_running);
+    bool is_animating(bool highlights_running) const;
     void prepare_card_faces();
+    qint64 raster_cache_bytes() const;
     void apply_theme();
     void apply_settings_from(const table_slot& source);
+    void refresh_strategies(const QStringList& changed_names);
     void set_copy_button_text(const QString& text);
     bool is_deck_exhausted() const;
+    int current_card_index() const;
+    std::array<int, rank_counter::ranks_count> seen_rank_counts() const;
+    QString strategy_name() const;
     bool is_quiz_prompt_active() const;
 
 signals:
@@ -41,6 +67,8 @@ signals:
     void copy_clicked(table_slot* slot);
     void copy_all_clicked(table_slot* slot);
     void rasterization_busy_changed(bool busy);
+    void animation_started();
+    void availability_changed();
     void dialog_opened();
     void score_adjusted(int correct_delta, int total_delta);
 
@@ -89,11 +117,12 @@ private:
     bool is_rotated;
     bool use_dialog_for_settings;
     int deck_count_minimum;
-    bool quiz_prompt_active;
     bool quiz_feedback_active;
     bool quiz_continue_visible;
     bool allow_skipping_flag;
     int last_quiz_input_value;
+    session_recorder* recorder;
+    int recorder_slot_index;
 
     void setup_overlay();
     void update_overlay_layout();
@@ -103,6 +132,7 @@ private:
     bool is_training_enabled() const;
     void show_quiz_prompt();
     void clear_quiz_prompt();
+    void emit_score_change(const slot_score& before);
     void show_quiz_feedback(const QString& message, bool show_continue);
     void update_quiz_controls_visibility();
     void update_strategy_weights(const QString& strategy_name);
@@ -0,0 +1,30 @@
+#!/usr/bin/env bash
+
+set -Eeuo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+source "$SCRIPT_DIR/lib/common.sh"
+
+output="${1:-}"
+build_type="${BUILD_TYPE:-Release}"
+parallel="${PARALLEL:-$(nproc_safe)}"
+build_dir="$ROOT_DIR/build-bench"
+
+cmake -S "$ROOT_DIR" -B "$build_dir" \
+  -DKDE=OFF \
+  -DBUILD_UNIT_TESTS=OFF \
+  -DBUILD_BENCHMARKS=ON \
+  -DCMAKE_BUILD_TYPE="$build_type"
+
+cmake --build "$build_dir" --parallel "$parallel" --target kcuckounter_bench
+
+# The benchmarks read assets/ relative to the working directory.
+if [[ -n "$output" ]]; then
+  output="$(realpath -m "$output")"
+fi
+cd "$build_dir"
+if [[ -n "$output" ]]; then
+  ./kcuckounter_bench --output "$output"
+else
+  ./kcuckounter_bench
+fi
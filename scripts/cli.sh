@@ -15,6 +15,7 @@ Commands:
   run {kde|nonkde|android-emulator|android-device}
                                    Run the app
   run-mem {kde|nonkde}              Run the app with memory usage statistics
+  bench [file]                      Build in Release and run the benchmarks
   leaks {kde|nonkde} [--tests]      Run ASan leak checks (optionally via tests)
   format                            Run clang-format over sources
   android env                       Print Android env export guidance
@@ -44,6 +45,9 @@ case "$cmd" in
   run-mem)
     "$SCRIPT_DIR/run_mem_stats.sh" "${1:-}"
     ;;
+  bench)
+    "$SCRIPT_DIR/bench.sh" "${1:-}"
+    ;;
   leaks)
     "$SCRIPT_DIR/check_leaks.sh" "${1:-nonkde}" "${2:-}"
     ;;
@@ -41,4 +41,4 @@ else
 fi
 
 log "Running $bin with memory usage statistics..."
-"${time_cmd[@]}" "$bin"
+"${time_cmd[@]}" "$bin" --mem-report
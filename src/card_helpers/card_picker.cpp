@@ -1,110 +1,64 @@
 #include "card_helpers/card_picker.hpp"
 
-#include <algorithm>
+#include <utility>
 
 card_picker::card_picker()
-    : deck()
-    , deck_position(0)
-    , infinity(false)
-    , random_gen() { }
+    : card_picker(std::make_shared<shoe_bank>()) { }
 
-void card_picker::setup(
-    int cards_per_deck, int decks_count, bool infinity_enabled
-) {
-    fill_deck(cards_per_deck, decks_count);
-    shuffle_deck();
-    deck_position = 0;
-    infinity = infinity_enabled;
-}
+card_picker::card_picker(std::shared_ptr<shoe_bank> bank)
+    : shoes(std::move(bank))
+    , slot(shoes->add_slot()) { }
 
-void card_picker::set_infinity(bool enabled) { infinity = enabled; }
+card_picker::~card_picker() { shoes->remove_slot(slot); }
 
-void card_picker::advance() {
-    if (deck.empty()) {
+void card_picker::attach(std::shared_ptr<shoe_bank> bank) {
+    if (bank == nullptr || bank == shoes) {
         return;
     }
 
-    if (infinity) {
-        if (deck_position + 1 >= static_cast<int>(deck.size())) {
-            shuffle_deck();
-            deck_position = 0;
-        } else {
-            ++deck_position;
-        }
-        return;
-    }
+    const random_generator generator = shoes->generator(slot);
+    shoes->remove_slot(slot);
+    shoes = std::move(bank);
+    slot = shoes->add_slot();
+    shoes->reseed(slot, generator);
+}
 
-    if (deck_position + 1 >= static_cast<int>(deck.size())) {
-        deck_position = static_cast<int>(deck.size());
-        return;
-    }
+void card_picker::setup(
+    int cards_per_deck, int decks_count, bool infinity_enabled
+) {
+    shoes->setup(slot, cards_per_deck, decks_count, infinity_enabled);
+}
 
-    ++deck_position;
+void card_picker::set_infinity(bool enabled) {
+    shoes->set_infinity(slot, enabled);
 }
 
-void card_picker::mark_depleted() {
-    if (deck.empty()) {
-        return;
-    }
-    deck_position = static_cast<int>(deck.size());
+void card_picker::reseed(const random_generator& generator) {
+    shoes->reseed(slot, generator);
 }
 
-bool card_picker::has_cards() const { return !deck.empty(); }
+void card_picker::advance() { shoes->advance(slot); }
+
+void card_picker::mark_depleted() { shoes->mark_depleted(slot); }
+
+bool card_picker::has_cards() const { return shoes->has_cards(slot); }
 
 int card_picker::current_card_index() const {
-    if (deck_position < 0 || deck_position >= static_cast<int>(deck.size())) {
-        return -1;
-    }
-    return deck[static_cast<size_t>(deck_position)];
+    return shoes->current_card_index(slot);
 }
 
 int card_picker::current_position() const {
-    if (deck_position < 0 || deck_position >= static_cast<int>(deck.size())) {
-        return -1;
-    }
-    return deck_position;
+    return shoes->current_position(slot);
 }
 
-int card_picker::total_cards() const { return static_cast<int>(deck.size()); }
+int card_picker::total_cards() const { return shoes->total_cards(slot); }
 
-bool card_picker::is_depleted() const {
-    if (infinity) {
-        return false;
-    }
-    if (deck.empty()) {
-        return true;
-    }
-    return deck_position >= static_cast<int>(deck.size());
-}
+bool card_picker::is_depleted() const { return shoes->is_depleted(slot); }
 
 int card_picker::card_index_at(int position) const {
-    if (position < 0 || position >= static_cast<int>(deck.size())) {
-        return -1;
-    }
-    return deck[static_cast<size_t>(position)];
-}
-
-void card_picker::fill_deck(int cards_per_deck, int decks_count) {
-    deck.clear();
-
-    if (cards_per_deck <= 0 || decks_count <= 0) {
-        return;
-    }
-
-    deck.reserve(
-        static_cast<size_t>(cards_per_deck) * static_cast<size_t>(decks_count)
-    );
-    for (int deck_index = 0; deck_index < decks_count; ++deck_index) {
-        for (int card_index = 0; card_index < cards_per_deck; ++card_index) {
-            deck.push_back(card_index);
-        }
-    }
+    return shoes->card_index_at(slot, position);
 }
 
-void card_picker::shuffle_deck() {
-    if (deck.empty()) {
-        return;
-    }
-
-    random_gen.shuffle(deck.begin(), deck.end());
+int card_picker::remaining_of_rank(int bucket) const {
+    return shoes->remaining_of_rank(slot, bucket);
 }
@@ -0,0 +1,74 @@
+#include "card_helpers/rank_counter.hpp"
+
+namespace {
+
+constexpr int kStandardDeckCount = rank_counter::ranks_count * 4;
+
+}
+
+rank_counter::rank_counter()
+    : rank_weights()
+    , rank_seen()
+    , jokers_seen_value(0)
+    , total_seen_value(0)
+    , running_count_value(0) {
+    rank_weights.fill(0);
+    rank_seen.fill(0);
+}
+
+void rank_counter::reset() {
+    rank_seen.fill(0);
+    jokers_seen_value = 0;
+    total_seen_value = 0;
+    running_count_value = 0;
+}
+
+void rank_counter::add_card(int card_index) {
+    if (card_index < 0) {
+        return;
+    }
+    ++total_seen_value;
+
+    const int rank_index = rank_from_card_index(card_index);
+    if (rank_index < 0) {
+        ++jokers_seen_value;
+        return;
+    }
+
+    const auto slot = static_cast<std::size_t>(rank_index);
+    ++rank_seen[slot];
+    running_count_value += rank_weights[slot];
+}
+
+int rank_counter::running_count() const { return running_count_value; }
+
+int rank_counter::seen_count(int rank_index) const {
+    if (rank_index < 0 || rank_index >= ranks_count) {
+        return 0;
+    }
+    return rank_seen[static_cast<std::size_t>(rank_index)];
+}
+
+int rank_counter::jokers_seen() const { return jokers_seen_value; }
+
+int rank_counter::total_seen() const { return total_seen_value; }
+
+const std::array<int, rank_counter::ranks_count>&
+rank_counter::seen_counts() const {
+    return rank_seen;
+}
+
+int rank_counter::rank_from_card_index(int card_index) {
+    if (card_index < 0 || card_index >= kStandardDeckCount) {
+        return -1;
+    }
+    return card_index % ranks_count;
+}
+
+void rank_counter::recompute() {
+    int total = 0;
+    for (std::size_t rank = 0; rank < rank_seen.size(); ++rank) {
+        total += rank_weights[rank] * rank_seen[rank];
+    }
+    running_count_value = total;
+}
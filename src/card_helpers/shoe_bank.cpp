@@ -0,0 +1,374 @@
+#include "card_helpers/shoe_bank.hpp"
+
+#include "card_helpers/rank_counter.hpp"
+
+#include <algorithm>
+
+namespace {
+
+constexpr std::size_t kRankBuckets
+    = static_cast<std::size_t>(shoe_bank::rank_buckets);
+
+std::size_t bucket_offset(std::size_t slot) { return slot * kRankBuckets; }
+
+}
+
+shoe_bank::shoe_bank()
+    : cards()
+    , stamps()
+    , slot_offsets()
+    , slot_capacities()
+    , slot_sizes()
+    , slot_cursors()
+    , slot_cards_per_deck()
+    , slot_decks()
+    , slot_passes()
+    , slot_infinity()
+    , slot_active()
+    , rank_remaining()
+    , generators()
+    , free_slots()
+    , active_slots(0)
+    , unused_cards(0) { }
+
+int shoe_bank::add_slot() {
+    ++active_slots;
+    if (!free_slots.empty()) {
+        const int slot = free_slots.back();
+        free_slots.pop_back();
+        const auto index = static_cast<std::size_t>(slot);
+        slot_active[index] = 1;
+        generators[index] = random_generator();
+        return slot;
+    }
+
+    const int slot = static_cast<int>(slot_offsets.size());
+    slot_offsets.push_back(static_cast<int>(cards.size()));
+    slot_capacities.push_back(0);
+    slot_sizes.push_back(0);
+    slot_cursors.push_back(0);
+    slot_cards_per_deck.push_back(0);
+    slot_decks.push_back(0);
+    slot_passes.push_back(0);
+    slot_infinity.push_back(0);
+    slot_active.push_back(1);
+    rank_remaining.resize(rank_remaining.size() + kRankBuckets, 0);
+    generators.emplace_back();
+    return slot;
+}
+
+void shoe_bank::remove_slot(int slot) {
+    if (!is_valid_slot(slot)) {
+        return;
+    }
+
+    const auto index = static_cast<std::size_t>(slot);
+    unused_cards += slot_capacities[index];
+    slot_capacities[index] = 0;
+    slot_sizes[index] = 0;
+    slot_cursors[index] = 0;
+    slot_cards_per_deck[index] = 0;
+    slot_decks[index] = 0;
+    slot_infinity[index] = 0;
+    slot_active[index] = 0;
+    std::fill_n(
+        rank_remaining.begin()
+            + static_cast<std::ptrdiff_t>(bucket_offset(index)),
+        kRankBuckets, 0
+    );
+    free_slots.push_back(slot);
+    --active_slots;
+
+    if (unused_cards * 2 > static_cast<int>(cards.size())) {
+        compact();
+    }
+}
+
+int shoe_bank::slot_count() const { return active_slots; }
+
+void shoe_bank::setup(
+    int slot, int cards_per_deck, int decks_count, bool infinity
+) {
+    if (!is_valid_slot(slot)) {
+        return;
+    }
+
+    const auto index = static_cast<std::size_t>(slot);
+    if (cards_per_deck <= 0 || decks_count <= 0) {
+        cards_per_deck = 0;
+        decks_count = 0;
+    }
+    cards_per_deck = std::min(cards_per_deck, max_cards_per_deck);
+
+    const int count = cards_per_deck * decks_count;
+    reserve_cards(index, count);
+    slot_sizes[index] = count;
+    slot_cursors[index] = 0;
+    slot_cards_per_deck[index] = cards_per_deck;
+    slot_decks[index] = decks_count;
+    slot_infinity[index] = infinity ? 1 : 0;
+    start_pass(index);
+}
+
+void shoe_bank::reseed(int slot, const random_generator& generator) {
+    if (!is_valid_slot(slot)) {
+        return;
+    }
+    generators[static_cast<std::size_t>(slot)] = generator;
+}
+
+const random_generator& shoe_bank::generator(int slot) const {
+    return generators[static_cast<std::size_t>(slot)];
+}
+
+void shoe_bank::set_infinity(int slot, bool enabled) {
+    if (!is_valid_slot(slot)) {
+        return;
+    }
+    slot_infinity[static_cast<std::size_t>(slot)] = enabled ? 1 : 0;
+}
+
+void shoe_bank::advance(int slot) {
+    if (!is_valid_slot(slot)) {
+        return;
+    }
+
+    const auto index = static_cast<std::size_t>(slot);
+    const int size = slot_sizes[index];
+    if (size == 0) {
+        return;
+    }
+
+    int& cursor = slot_cursors[index];
+    if (cursor + 1 < size) {
+        ++cursor;
+        draw_current_card(index);
+        return;
+    }
+
+    if (slot_infinity[index] == 0) {
+        cursor = size;
+        return;
+    }
+
+    start_pass(index);
+}
+
+void shoe_bank::mark_depleted(int slot) {
+    if (!is_valid_slot(slot)) {
+        return;
+    }
+
+    const auto index = static_cast<std::size_t>(slot);
+    if (slot_sizes[index] == 0) {
+        return;
+    }
+    slot_cursors[index] = slot_sizes[index];
+    std::fill_n(
+        rank_remaining.begin()
+            + static_cast<std::ptrdiff_t>(bucket_offset(index)),
+        kRankBuckets, 0
+    );
+}
+
+bool shoe_bank::has_cards(int slot) const {
+    return is_valid_slot(slot)
+        && slot_sizes[static_cast<std::size_t>(slot)] > 0;
+}
+
+int shoe_bank::current_card_index(int slot) const {
+    return card_index_at(slot, current_position(slot));
+}
+
+int shoe_bank::current_position(int slot) const {
+    if (!is_valid_slot(slot)) {
+        return -1;
+    }
+
+    const auto index = static_cast<std::size_t>(slot);
+    const int cursor = slot_cursors[index];
+    if (cursor >= slot_sizes[index]) {
+        return -1;
+    }
+    return cursor;
+}
+
+int shoe_bank::total_cards(int slot) const {
+    if (!is_valid_slot(slot)) {
+        return 0;
+    }
+    return slot_sizes[static_cast<std::size_t>(slot)];
+}
+
+bool shoe_bank::is_depleted(int slot) const {
+    if (!is_valid_slot(slot)) {
+        return true;
+    }
+
+    const auto index = static_cast<std::size_t>(slot);
+    if (slot_infinity[index] != 0) {
+        return false;
+    }
+    return slot_cursors[index] >= slot_sizes[index];
+}
+
+bool shoe_bank::is_infinity(int slot) const {
+    return is_valid_slot(slot)
+        && slot_infinity[static_cast<std::size_t>(slot)] != 0;
+}
+
+int shoe_bank::card_index_at(int slot, int position) const {
+    if (!is_valid_slot(slot)) {
+        return -1;
+    }
+
+    const auto index = static_cast<std::size_t>(slot);
+    if (position < 0 || position >= slot_sizes[index]) {
+        return -1;
+    }
+    return card_at(index, position);
+}
+
+int shoe_bank::remaining_cards(int slot) const {
+    if (!is_valid_slot(slot)) {
+        return 0;
+    }
+
+    const auto index = static_cast<std::size_t>(slot);
+    const int size = slot_sizes[index];
+    const int cursor = slot_cursors[index];
+    if (cursor >= size) {
+        return 0;
+    }
+    return size - cursor - 1;
+}
+
+int shoe_bank::remaining_of_rank(int slot, int bucket) const {
+    if (!is_valid_slot(slot) || bucket < 0 || bucket >= rank_buckets) {
+        return 0;
+    }
+    return rank_remaining
+        [bucket_offset(static_cast<std::size_t>(slot))
+         + static_cast<std::size_t>(bucket)];
+}
+
+std::size_t shoe_bank::buffer_size() const { return cards.size(); }
+
+int shoe_bank::rank_bucket(int card_index) {
+    if (card_index < 0) {
+        return -1;
+    }
+
+    const int rank_index = rank_counter::rank_from_card_index(card_index);
+    if (rank_index < 0) {
+        return rank_buckets - 1;
+    }
+    return rank_index;
+}
+
+bool shoe_bank::is_valid_slot(int slot) const {
+    return slot >= 0 && slot < static_cast<int>(slot_active.size())
+        && slot_active[static_cast<std::size_t>(slot)] != 0;
+}
+
+void shoe_bank::reserve_cards(std::size_t slot, int count) {
+    if (count <= slot_capacities[slot]) {
+        return;
+    }
+
+    unused_cards += slot_capacities[slot];
+    slot_offsets[slot] = static_cast<int>(cards.size());
+    slot_capacities[slot] = count;
+    cards.resize(cards.size() + static_cast<std::size_t>(count));
+    stamps.resize(cards.size(), 0);
+
+    if (unused_cards * 2 > static_cast<int>(cards.size())) {
+        compact();
+    }
+}
+
+void shoe_bank::compact() {
+    const std::size_t used
+        = cards.size() - static_cast<std::size_t>(unused_cards);
+    std::vector<std::uint8_t> packed_cards;
+    std::vector<std::uint8_t> packed_stamps;
+    packed_cards.reserve(used);
+    packed_stamps.reserve(used);
+
+    for (std::size_t slot = 0; slot < slot_offsets.size(); ++slot) {
+        const int offset = slot_offsets[slot];
+        const int capacity = slot_capacities[slot];
+        slot_offsets[slot] = static_cast<int>(packed_cards.size());
+        packed_cards.insert(
+            packed_cards.end(), cards.begin() + offset,
+            cards.begin() + offset + capacity
+        );
+        packed_stamps.insert(
+            packed_stamps.end(), stamps.begin() + offset,
+            stamps.begin() + offset + capacity
+        );
+    }
+
+    cards.swap(packed_cards);
+    stamps.swap(packed_stamps);
+    unused_cards = 0;
+}
+
+void shoe_bank::start_pass(std::size_t slot) {
+    std::uint8_t& pass = slot_passes[slot];
+    ++pass;
+    if (pass == 0) {
+        const auto begin = stamps.begin() + slot_offsets[slot];
+        std::fill(begin, begin + slot_capacities[slot], std::uint8_t { 0 });
+        pass = 1;
+    }
+
+    slot_cursors[slot] = 0;
+    reset_remaining(slot);
+    draw_current_card(slot);
+}
+
+void shoe_bank::reset_remaining(std::size_t slot) {
+    const auto counts = rank_remaining.begin()
+        + static_cast<std::ptrdiff_t>(bucket_offset(slot));
+    std::fill_n(counts, kRankBuckets, 0);
+
+    const int decks_count = slot_decks[slot];
+    for (int card_index = 0; card_index < slot_cards_per_deck[slot];
+         ++card_index) {
+        counts[rank_bucket(card_index)] += decks_count;
+    }
+}
+
+void shoe_bank::draw_current_card(std::size_t slot) {
+    const int cursor = slot_cursors[slot];
+    const int size = slot_sizes[slot];
+    if (cursor >= size) {
+        return;
+    }
+
+    const auto span = static_cast<std::uint32_t>(size - cursor);
+    const int pick = cursor + static_cast<int>(generators[slot].bounded(span));
+    const int card_index = card_at(slot, pick);
+    if (pick != cursor) {
+        store_card(slot, pick, card_at(slot, cursor));
+    }
+    store_card(slot, cursor, card_index);
+
+    const auto bucket = static_cast<std::size_t>(rank_bucket(card_index));
+    --rank_remaining[bucket_offset(slot) + bucket];
+}
+
+int shoe_bank::card_at(std::size_t slot, int position) const {
+    const auto offset = static_cast<std::size_t>(slot_offsets[slot] + position);
+    if (stamps[offset] != slot_passes[slot]) {
+        return position % slot_cards_per_deck[slot];
+    }
+    return cards[offset];
+}
+
+void shoe_bank::store_card(std::size_t slot, int position, int card_index) {
+    const auto offset = static_cast<std::size_t>(slot_offsets[slot] + position);
+    cards[offset] = static_cast<std::uint8_t>(card_index);
+    stamps[offset] = slot_passes[slot];
+}
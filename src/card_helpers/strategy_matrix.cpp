@@ -0,0 +1,167 @@
+#include "card_helpers/strategy_matrix.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kLanes = static_cast<std::size_t>(strategy_matrix::lanes);
+constexpr std::size_t kRankPairs
+    = static_cast<std::size_t>(strategy_matrix::rank_pairs);
+
+std::int16_t clamp_to_lane(int value) {
+    return static_cast<std::int16_t>(std::clamp<int>(
+        value, std::numeric_limits<std::int16_t>::min(),
+        std::numeric_limits<std::int16_t>::max()
+    ));
+}
+
+// Offset of the weight pair of strategy s for ranks (2p, 2p + 1).
+std::size_t pair_offset(std::size_t padded, std::size_t pair, std::size_t s) {
+    return (pair * padded + s) * 2;
+}
+
+bool fits_in_lanes(const std::array<int, strategy_matrix::ranks_count>& seen) {
+    return std::all_of(seen.begin(), seen.end(), [](int count) {
+        return count >= 0 && count <= std::numeric_limits<std::int16_t>::max();
+    });
+}
+
+}
+
+strategy_matrix::strategy_matrix()
+    : weights()
+    , padded_strategies(0)
+    , strategies(0) { }
+
+void strategy_matrix::clear() {
+    weights.clear();
+    padded_strategies = 0;
+    strategies = 0;
+}
+
+int strategy_matrix::strategies_count() const { return strategies; }
+
+int strategy_matrix::weight(int strategy, int rank_index) const {
+    if (strategy < 0 || strategy >= strategies || rank_index < 0
+        || rank_index >= ranks_count) {
+        return 0;
+    }
+    const auto rank = static_cast<std::size_t>(rank_index);
+    return weights[pair_offset(
+                       padded_count(), rank / 2,
+                       static_cast<std::size_t>(strategy)
+                   )
+                   + rank % 2];
+}
+
+void strategy_matrix::running_counts(
+    const std::array<int, ranks_count>& seen, std::vector<int>& counts
+) const {
+    counts.resize(static_cast<std::size_t>(strategies));
+    if (strategies == 0) {
+        return;
+    }
+
+    const std::size_t padded = padded_count();
+    if (!fits_in_lanes(seen)) {
+        for (std::size_t s = 0; s < counts.size(); ++s) {
+            int total = 0;
+            for (int rank = 0; rank < ranks_count; ++rank) {
+                total += weight(static_cast<int>(s), rank)
+                    * seen[static_cast<std::size_t>(rank)];
+            }
+            counts[s] = total;
+        }
+        return;
+    }
+
+    std::array<std::int16_t, kRankPairs * 2> seen_pairs {};
+    for (std::size_t rank = 0; rank < seen.size(); ++rank) {
+        seen_pairs[rank] = static_cast<std::int16_t>(seen[rank]);
+    }
+
+#if defined(__SSE2__)
+    for (std::size_t block = 0; block < padded; block += kLanes) {
+        __m128i sum = _mm_setzero_si128();
+        for (std::size_t pair = 0; pair < kRankPairs; ++pair) {
+            const auto low = static_cast<std::uint16_t>(seen_pairs[pair * 2]);
+            const auto high
+                = static_cast<std::uint16_t>(seen_pairs[pair * 2 + 1]);
+            const __m128i counts_pair = _mm_set1_epi32(
+                static_cast<int>(static_cast<std::uint32_t>(high) << 16u | low)
+            );
+            const __m128i row = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(
+                    weights.data() + pair_offset(padded, pair, block)
+                )
+            );
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(row, counts_pair));
+        }
+
+        alignas(16) std::array<std::int32_t, kLanes> lane_sums {};
+        _mm_store_si128(reinterpret_cast<__m128i*>(lane_sums.data()), sum);
+        const std::size_t used = std::min(kLanes, counts.size() - block);
+        std::copy_n(
+            lane_sums.begin(), used,
+            counts.begin() + static_cast<std::ptrdiff_t>(block)
+        );
+    }
+#else
+    std::fill(counts.begin(), counts.end(), 0);
+    for (std::size_t pair = 0; pair < kRankPairs; ++pair) {
+        const std::int32_t low = seen_pairs[pair * 2];
+        const std::int32_t high = seen_pairs[pair * 2 + 1];
+        const std::int16_t* row = weights.data() + pair_offset(padded, pair, 0);
+        for (std::size_t s = 0; s < counts.size(); ++s) {
+            counts[s] += row[s * 2] * low + row[s * 2 + 1] * high;
+        }
+    }
+#endif
+}
+
+std::vector<int>
+strategy_matrix::running_counts(const std::array<int, ranks_count>& seen
+) const {
+    std::vector<int> counts;
+    running_counts(seen, counts);
+    return counts;
+}
+
+int strategy_matrix::add_row(const std::array<int, ranks_count>& row) {
+    const auto index = static_cast<std::size_t>(strategies);
+    if (index >= padded_count()) {
+        grow(padded_count() + kLanes);
+    }
+
+    const std::size_t padded = padded_count();
+    for (std::size_t rank = 0; rank < row.size(); ++rank) {
+        weights[pair_offset(padded, rank / 2, index) + rank % 2]
+            = clamp_to_lane(row[rank]);
+    }
+    return strategies++;
+}
+
+std::size_t strategy_matrix::padded_count() const {
+    return padded_strategies;
+}
+
+void strategy_matrix::grow(std::size_t padded) {
+    const std::size_t old_padded = padded_count();
+    std::vector<std::int16_t> resized(kRankPairs * padded * 2, 0);
+    for (std::size_t pair = 0; pair < kRankPairs; ++pair) {
+        std::copy_n(
+            weights.begin()
+                + static_cast<std::ptrdiff_t>(pair_offset(old_padded, pair, 0)),
+            old_padded * 2,
+            resized.begin()
+                + static_cast<std::ptrdiff_t>(pair_offset(padded, pair, 0))
+        );
+    }
+    weights.swap(resized);
+    padded_strategies = padded;
+}
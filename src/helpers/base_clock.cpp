@@ -1,16 +1,16 @@
 #include "helpers/base_clock.hpp"
 
 #include "helpers/str_label.hpp"
+#include "helpers/time_source.hpp"
 
-#include <QElapsedTimer>
 #include <QTime>
-#include <QTimer>
 
 #include <utility>
 
 struct BaseClock::base_clock_state {
-    QTimer timer;
-    QElapsedTimer elapsed_timer;
+    std::shared_ptr<time_source> source = time_source::instance();
+    std::unique_ptr<time_source::timer> timer;
+    std::int64_t started_ns = 0;
     qint64 elapsed_ms = 0;
     qint64 last_tick_ms = 0;
     bool running = false;
@@ -21,21 +21,19 @@ struct BaseClock::base_clock_state {
 BaseClock::BaseClock(QObject* parent)
     : QObject(parent)
     , state(std::make_unique<base_clock_state>()) {
-    state->timer.setInterval(100);
-    QObject::connect(
-        &state->timer, &QTimer::timeout, this, &BaseClock::on_timeout
-    );
+    state->timer = state->source->create_timer([this]() { on_timeout(); });
+    state->timer->set_interval(100);
 }
 
 BaseClock::~BaseClock() = default;
 
 void BaseClock::set_interval(int interval_ms) {
-    state->timer.setInterval(interval_ms);
+    state->timer->set_interval(interval_ms);
 }
 
 void BaseClock::set_single_shot(bool single_shot) {
     state->single_shot = single_shot;
-    state->timer.setSingleShot(single_shot);
+    state->timer->set_single_shot(single_shot);
 }
 
 void BaseClock::start(bool emit_immediately) {
@@ -44,8 +42,8 @@ void BaseClock::start(bool emit_immediately) {
     }
     state->running = true;
     state->elapsed_active = true;
-    state->elapsed_timer.start();
-    state->timer.start();
+    state->started_ns = state->source->now_ns();
+    state->timer->start();
     if (emit_immediately) {
         on_timeout();
     }
@@ -55,15 +53,15 @@ void BaseClock::pause() {
     if (!state->running) {
         return;
     }
-    state->elapsed_ms += state->elapsed_timer.elapsed();
+    state->elapsed_ms += running_elapsed_ms();
     state->running = false;
     state->elapsed_active = false;
-    state->timer.stop();
+    state->timer->stop();
     on_timeout();
 }
 
 void BaseClock::stop() {
-    state->timer.stop();
+    state->timer->stop();
     state->running = false;
     state->elapsed_active = false;
 }
@@ -73,24 +71,28 @@ void BaseClock::reset() {
     state->last_tick_ms = 0;
     state->running = false;
     state->elapsed_active = false;
-    state->timer.stop();
+    state->timer->stop();
     on_timeout();
 }
 
-bool BaseClock::is_active() const { return state->timer.isActive(); }
+bool BaseClock::is_active() const { return state->timer->is_active(); }
 
 void BaseClock::restart_elapsed() {
     state->elapsed_ms = 0;
     state->last_tick_ms = 0;
     state->running = false;
     state->elapsed_active = true;
-    state->elapsed_timer.start();
+    state->started_ns = state->source->now_ns();
+}
+
+qint64 BaseClock::running_elapsed_ms() const {
+    return (state->source->now_ns() - state->started_ns) / 1000000;
 }
 
 qint64 BaseClock::elapsed_time_ms() const {
     qint64 total_ms = state->elapsed_ms;
     if (state->running || state->elapsed_active) {
-        total_ms += state->elapsed_timer.elapsed();
+        total_ms += running_elapsed_ms();
     }
     return total_ms;
 }
@@ -114,7 +116,9 @@ QString BaseClock::time_string_hh_mm_ss() const {
 void BaseClock::single_shot(
     const int interval_ms, QObject* context, std::function<void()> handler
 ) {
-    QTimer::singleShot(interval_ms, context, std::move(handler));
+    time_source::instance()->single_shot(
+        interval_ms, context, std::move(handler)
+    );
 }
 
 void BaseClock::on_timeout() {
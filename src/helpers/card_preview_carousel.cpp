@@ -1,18 +1,51 @@
 #include "helpers/card_preview_carousel.hpp"
 
+#include "helpers/preview_cache.hpp"
+#include "helpers/trace_recorder.hpp"
+
+#include <QFutureWatcher>
 #include <QHBoxLayout>
+#include <QPainter>
 #include <QResizeEvent>
 #include <QStyle>
+#include <QtConcurrent>
 
 #include <algorithm>
 #include <cmath>
+#include <optional>
 #include <utility>
 
+namespace {
+qint64 pixmap_bytes(const QPixmap& pixmap) {
+    return static_cast<qint64>(pixmap.width()) * pixmap.height()
+        * pixmap.depth() / 8;
+}
+} // namespace
+
+bool card_preview_carousel::view_window::wants(
+    int card_index, std::uint64_t request_generation
+) const {
+    if (generation.load() != request_generation) {
+        return false;
+    }
+    const int total_cards = total.load();
+    if (total_cards <= 0) {
+        return false;
+    }
+    const int offset = card_index - (first.load() - 1);
+    return ((offset % total_cards) + total_cards) % total_cards < span.load();
+}
+
 card_preview_carousel::card_preview_carousel(BaseWidget* parent)
     : BaseWidget(parent)
     , cached_cards()
+    , pending_cards()
     , card_provider()
+    , provider_cache_tag()
+    , window(std::make_shared<view_window>())
+    , placeholder_pixmap()
     , card_labels()
+    , cache_memory(trace_counter::preview_cache_bytes)
     , first_index(0)
     , visible_count_value(5)
     , min_visible_count_value(3)
@@ -61,17 +94,23 @@ card_preview_carousel::card_preview_carousel(BaseWidget* parent)
 void card_preview_carousel::set_cards(const QVector<QPixmap>& next_cards) {
     cached_cards = next_cards;
     card_provider = {};
+    provider_cache_tag.clear();
+    ++window->generation;
+    pending_cards.clear();
     total_cards_value = static_cast<int>(cached_cards.size());
     first_index = 0;
     refresh_view();
 }
 
 void card_preview_carousel::set_card_provider(
-    int count, std::function<QPixmap(int, const QSize&)> provider
+    int count, card_renderer provider, const QString& cache_tag
 ) {
     total_cards_value = std::max(0, count);
     card_provider = std::move(provider);
+    provider_cache_tag = cache_tag;
+    ++window->generation;
     cached_cards = QVector<QPixmap>(total_cards_value);
+    pending_cards = QVector<bool>(total_cards_value, false);
     first_index = 0;
     refresh_view();
 }
@@ -240,12 +279,126 @@ void card_preview_carousel::update_card_dimensions() {
 }
 
 void card_preview_carousel::clear_cached_cards() {
+    placeholder_pixmap = QPixmap();
     if (card_provider) {
+        ++window->generation;
         cached_cards.fill(QPixmap());
+        pending_cards.fill(false);
     }
+    report_cache_bytes();
+}
+
+const QPixmap& card_preview_carousel::placeholder() {
+    if (placeholder_pixmap.isNull() && card_size.isValid()) {
+        placeholder_pixmap = QPixmap(card_size);
+        placeholder_pixmap.fill(Qt::transparent);
+        QPainter painter(&placeholder_pixmap);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        QColor outline = palette().color(QPalette::Mid);
+        outline.setAlpha(160);
+        painter.setPen(QPen(outline, 1.0, Qt::DashLine));
+        const qreal radius = card_size.width() * 0.06;
+        painter.drawRoundedRect(
+            QRectF(placeholder_pixmap.rect()).adjusted(0.5, 0.5, -0.5, -0.5),
+            radius, radius
+        );
+        painter.end();
+    }
+    return placeholder_pixmap;
+}
+
+QSize card_preview_carousel::render_size() const {
+    if (provider_cache_tag.isEmpty()) {
+        return card_size;
+    }
+    return preview_cache::bucket_size(card_size);
+}
+
+void card_preview_carousel::publish_window() {
+    window->first.store(first_index);
+    window->span.store(static_cast<int>(card_labels.size()) + 2);
+    window->total.store(total_cards_value);
+}
+
+void card_preview_carousel::request_card(int card_index) {
+    if (!card_provider || card_index < 0
+        || card_index >= pending_cards.size() || pending_cards[card_index]
+        || !cached_cards[card_index].isNull()) {
+        return;
+    }
+    if (!provider_cache_tag.isEmpty()) {
+        const QPixmap shared = preview_cache::instance().find(
+            provider_cache_tag, card_index, card_size
+        );
+        if (!shared.isNull()) {
+            cached_cards[card_index] = shared;
+            show_card(card_index);
+            return;
+        }
+    }
+    pending_cards[card_index] = true;
+
+    const std::uint64_t generation = window->generation.load();
+    auto watcher = new QFutureWatcher<std::optional<QImage>>(this);
+    QObject::connect(
+        watcher, &QFutureWatcher<std::optional<QImage>>::finished, this,
+        [this, watcher, card_index, generation]() {
+            watcher->deleteLater();
+            if (!window->wants(card_index, generation)) {
+                if (window->generation.load() == generation) {
+                    pending_cards[card_index] = false;
+                }
+                return;
+            }
+            pending_cards[card_index] = false;
+            const std::optional<QImage> image = watcher->result();
+            if (!image.has_value()) {
+                // Skipped while out of view, but scrolled back since.
+                request_card(card_index);
+                return;
+            }
+            if (!image->isNull()) {
+                cached_cards[card_index] = QPixmap::fromImage(*image);
+                if (!provider_cache_tag.isEmpty()) {
+                    preview_cache::instance().insert(
+                        provider_cache_tag, card_index, card_size,
+                        cached_cards[card_index]
+                    );
+                }
+                show_card(card_index);
+            }
+        }
+    );
+    watcher->setFuture(QtConcurrent::run(
+        [provider = card_provider, shared_window = window, card_index,
+         size = render_size(), generation]() -> std::optional<QImage> {
+            if (!shared_window->wants(card_index, generation)) {
+                return std::nullopt;
+            }
+            const trace_zone zone(
+                "card_preview_carousel::provider", "raster"
+            );
+            return provider(card_index, size);
+        }
+    ));
+}
+
+void card_preview_carousel::show_card(int card_index) {
+    const int total_cards = total_cards_value;
+    if (total_cards <= 0) {
+        return;
+    }
+    for (int i = 0; i < card_labels.size(); ++i) {
+        QLabel* label = card_labels[i];
+        if (label != nullptr && (first_index + i) % total_cards == card_index) {
+            label->setPixmap(cached_cards[card_index]);
+        }
+    }
+    report_cache_bytes();
 }
 
 void card_preview_carousel::refresh_view() {
+    const trace_zone zone("card_preview_carousel::refresh_view", "raster");
     const int total_cards = total_cards_value;
     if (total_cards <= 0) {
         for (QLabel* label : card_labels) {
@@ -259,65 +412,46 @@ void card_preview_carousel::refresh_view() {
         return;
     }
     const int label_count = static_cast<int>(card_labels.size());
-    QVector<bool> keep_cache;
-    if (card_provider && !cached_cards.isEmpty()) {
-        keep_cache = QVector<bool>(total_cards, false);
-    }
+    publish_window();
     for (int i = 0; i < label_count; ++i) {
         QLabel* label = card_labels[i];
         if (label == nullptr) {
             continue;
         }
         const int card_index = (first_index + i) % total_cards;
-        if (!keep_cache.isEmpty() && card_index >= 0
-            && card_index < keep_cache.size()) {
-            keep_cache[card_index] = true;
-        }
-        QPixmap pixmap;
-        if (!cached_cards.isEmpty() && card_index >= 0
-            && card_index < cached_cards.size()) {
-            pixmap = cached_cards[card_index];
-            if (pixmap.isNull() && card_provider) {
-                pixmap = card_provider(card_index, card_size);
-                cached_cards[card_index] = pixmap;
-            }
-        } else if (card_provider) {
-            pixmap = card_provider(card_index, card_size);
-        }
+        const QPixmap pixmap = card_index < cached_cards.size()
+            ? cached_cards[card_index]
+            : QPixmap();
         if (!pixmap.isNull()) {
             label->setPixmap(pixmap);
+        } else if (card_provider) {
+            label->setPixmap(placeholder());
+            request_card(card_index);
         } else {
             label->clear();
         }
         label->setVisible(true);
     }
 
-    if (card_provider && !cached_cards.isEmpty()) {
-        const int prev_index = (first_index - 1 + total_cards) % total_cards;
-        const int next_index = (first_index + label_count) % total_cards;
-        if (prev_index >= 0 && prev_index < cached_cards.size()
-            && cached_cards[prev_index].isNull()) {
-            cached_cards[prev_index] = card_provider(prev_index, card_size);
-        }
-        if (next_index >= 0 && next_index < cached_cards.size()
-            && cached_cards[next_index].isNull()) {
-            cached_cards[next_index] = card_provider(next_index, card_size);
-        }
-        if (!keep_cache.isEmpty()) {
-            if (prev_index >= 0 && prev_index < keep_cache.size()) {
-                keep_cache[prev_index] = true;
-            }
-            if (next_index >= 0 && next_index < keep_cache.size()) {
-                keep_cache[next_index] = true;
-            }
-            for (int i = 0; i < cached_cards.size(); ++i) {
-                if (!keep_cache[i]) {
-                    cached_cards[i] = QPixmap();
-                }
+    if (card_provider) {
+        request_card((first_index - 1 + total_cards) % total_cards);
+        request_card((first_index + label_count) % total_cards);
+        for (int i = 0; i < cached_cards.size(); ++i) {
+            if (!window->wants(i, window->generation.load())) {
+                cached_cards[i] = QPixmap();
             }
         }
     }
 
     previous_button->setEnabled(total_cards_value > 1);
     next_button->setEnabled(total_cards_value > 1);
+    report_cache_bytes();
+}
+
+void card_preview_carousel::report_cache_bytes() {
+    qint64 bytes = pixmap_bytes(placeholder_pixmap);
+    for (const QPixmap& pixmap : cached_cards) {
+        bytes += pixmap_bytes(pixmap);
+    }
+    cache_memory.set(bytes);
 }
@@ -0,0 +1,166 @@
+#include "helpers/deal_scheduler.hpp"
+
+#include "helpers/trace_recorder.hpp"
+
+#include <algorithm>
+
+namespace {
+
+constexpr std::int64_t kNsPerMs = 1000000;
+
+}
+
+deal_timeline::deal_timeline()
+    : interval_ns(300 * kNsPerMs)
+    , next_deadline_ns(0)
+    , paused_remaining_ns(0)
+    , current_policy(catch_up_policy::drop)
+    , running(false)
+    , paused(false) { }
+
+void deal_timeline::set_interval(
+    std::int64_t interval_ns, std::int64_t now_ns
+) {
+    interval_ns = std::max(interval_ns, min_interval_ns);
+    if (running) {
+        const std::int64_t last_deal_ns = next_deadline_ns - this->interval_ns;
+        next_deadline_ns = std::max(now_ns, last_deal_ns + interval_ns);
+    } else if (paused) {
+        paused_remaining_ns = std::min(paused_remaining_ns, interval_ns);
+    }
+    this->interval_ns = interval_ns;
+}
+
+void deal_timeline::set_policy(catch_up_policy policy) {
+    current_policy = policy;
+}
+
+void deal_timeline::start(std::int64_t now_ns) {
+    next_deadline_ns = now_ns + interval_ns;
+    paused_remaining_ns = 0;
+    running = true;
+    paused = false;
+}
+
+void deal_timeline::pause(std::int64_t now_ns) {
+    if (!running) {
+        return;
+    }
+    paused_remaining_ns = std::max<std::int64_t>(0, next_deadline_ns - now_ns);
+    running = false;
+    paused = true;
+}
+
+void deal_timeline::resume(std::int64_t now_ns) {
+    if (!paused) {
+        start(now_ns);
+        return;
+    }
+    next_deadline_ns = now_ns + paused_remaining_ns;
+    running = true;
+    paused = false;
+}
+
+void deal_timeline::stop() {
+    running = false;
+    paused = false;
+    paused_remaining_ns = 0;
+}
+
+int deal_timeline::take_due(std::int64_t now_ns) {
+    if (!running || now_ns < next_deadline_ns) {
+        return 0;
+    }
+
+    const std::int64_t missed = (now_ns - next_deadline_ns) / interval_ns;
+    switch (current_policy) {
+    case catch_up_policy::burst: {
+        const auto due = static_cast<int>(
+            std::min<std::int64_t>(missed + 1, max_burst)
+        );
+        next_deadline_ns += due * interval_ns;
+        return due;
+    }
+    case catch_up_policy::stretch:
+        next_deadline_ns = now_ns + interval_ns;
+        return 1;
+    case catch_up_policy::drop:
+        break;
+    }
+    next_deadline_ns += (missed + 1) * interval_ns;
+    return 1;
+}
+
+bool deal_timeline::is_running() const { return running; }
+
+bool deal_timeline::is_paused() const { return paused; }
+
+std::int64_t deal_timeline::interval() const { return interval_ns; }
+
+std::int64_t deal_timeline::next_deadline() const { return next_deadline_ns; }
+
+catch_up_policy deal_timeline::policy() const { return current_policy; }
+
+deal_scheduler::deal_scheduler(QObject* parent)
+    : QObject(parent)
+    , source(time_source::instance())
+    , timer(source->create_timer([this]() { on_timeout(); }))
+    , timeline() {
+    timer->set_single_shot(true);
+    timer->set_precise(true);
+}
+
+void deal_scheduler::set_interval_ms(int interval_ms) {
+    timeline.set_interval(interval_ms * kNsPerMs, now_ns());
+    arm();
+}
+
+void deal_scheduler::set_policy(catch_up_policy policy) {
+    timeline.set_policy(policy);
+}
+
+void deal_scheduler::set_active(bool active) {
+    if (active == timeline.is_running()) {
+        return;
+    }
+    if (active) {
+        timeline.resume(now_ns());
+    } else {
+        timeline.pause(now_ns());
+    }
+    arm();
+}
+
+void deal_scheduler::stop() {
+    timeline.stop();
+    timer->stop();
+}
+
+bool deal_scheduler::is_running() const { return timeline.is_running(); }
+
+void deal_scheduler::on_timeout() {
+    const std::int64_t now = now_ns();
+    const std::int64_t lateness_ns = now - timeline.next_deadline();
+    trace_recorder::instance().raise_counter(
+        trace_counter::deal_jitter_us,
+        (lateness_ns < 0 ? -lateness_ns : lateness_ns) / 1000
+    );
+    const int due = timeline.take_due(now);
+    for (int deal = 0; deal < due && timeline.is_running(); ++deal) {
+        emit deal_due();
+    }
+    arm();
+}
+
+void deal_scheduler::arm() {
+    if (!timeline.is_running()) {
+        timer->stop();
+        return;
+    }
+    const std::int64_t wait_ns
+        = std::max<std::int64_t>(0, timeline.next_deadline() - now_ns());
+    timer->set_interval(static_cast<int>((wait_ns + kNsPerMs - 1) / kNsPerMs));
+    timer->start();
+}
+
+std::int64_t deal_scheduler::now_ns() const { return source->now_ns(); }
@@ -0,0 +1,62 @@
+#include "helpers/frame_clock.hpp"
+
+#include <QGuiApplication>
+#include <QScreen>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr qreal kFallbackRefreshRate = 60.0;
+constexpr int kMinFrameIntervalMs = 4;
+
+}
+
+frame_clock::frame_clock(QObject* parent)
+    : QObject(parent)
+    , source(time_source::instance())
+    , timer(source->create_timer([this]() { on_timeout(); }))
+    , last_frame_ns(0) {
+    timer->set_precise(true);
+    update_frame_interval();
+}
+
+void frame_clock::wake() {
+    if (timer->is_active()) {
+        return;
+    }
+    update_frame_interval();
+    last_frame_ns = source->now_ns();
+    timer->start();
+}
+
+void frame_clock::stop() { timer->stop(); }
+
+bool frame_clock::is_active() const { return timer->is_active(); }
+
+int frame_clock::frame_interval_ms() const { return timer->interval(); }
+
+void frame_clock::on_timeout() {
+    const std::int64_t now_ns = source->now_ns();
+    const qint64 delta_ms = (now_ns - last_frame_ns) / 1000000;
+    last_frame_ns += delta_ms * 1000000;
+    emit frame(delta_ms);
+}
+
+void frame_clock::update_frame_interval() {
+    qreal refresh_rate = kFallbackRefreshRate;
+    if (qobject_cast<QGuiApplication*>(QCoreApplication::instance())
+        != nullptr) {
+        const QScreen* screen = QGuiApplication::primaryScreen();
+        if (screen != nullptr && screen->refreshRate() > 1.0) {
+            refresh_rate = screen->refreshRate();
+        }
+    }
+    timer->set_interval(
+        std::max(
+            kMinFrameIntervalMs,
+            static_cast<int>(std::lround(1000.0 / refresh_rate))
+        )
+    );
+}
@@ -1,5 +1,7 @@
 #include "helpers/image_cacher.hpp"
 
+#include "helpers/trace_recorder.hpp"
+
 #include <QPainter>
 #include <QtGlobal>
 #include <cmath>
@@ -10,7 +12,8 @@ image_cacher::image_cacher(const QString& source_path)
     , cached_pixmap()
     , renderer()
     , base_scale(1.75)
-    , min_short_px(63) {
+    , min_short_px(63)
+    , cache_memory(trace_counter::marking_cache_bytes) {
     if (!source_path.isEmpty()) {
         renderer.load(source_path);
     }
@@ -81,8 +84,10 @@ QSize image_cacher::raster_cache_size(const QSize& desired_size) const {
 }
 
 void image_cacher::rasterize() {
+    const trace_zone zone("image_cacher::rasterize", "raster");
     if (!renderer.isValid() || target_size.isEmpty()) {
         cached_pixmap = QPixmap();
+        cache_memory.set(0);
         return;
     }
 
@@ -94,4 +99,8 @@ void image_cacher::rasterize() {
         &painter, QRectF(QPointF(0.0, 0.0), QSizeF(new_pixmap.size()))
     );
     cached_pixmap = new_pixmap;
+    cache_memory.set(
+        static_cast<qint64>(new_pixmap.width()) * new_pixmap.height()
+        * new_pixmap.depth() / 8
+    );
 }
@@ -0,0 +1,103 @@
+#include "helpers/memory_report.hpp"
+
+#include <array>
+#include <cstdio>
+#include <utility>
+
+namespace {
+const std::array<std::pair<const char*, trace_counter>, 5>& subsystems() {
+    static const std::array<std::pair<const char*, trace_counter>, 5> list {
+        { { "card face rasters", trace_counter::card_raster_bytes },
+          { "scaled card faces", trace_counter::scaled_face_bytes },
+          { "table markings", trace_counter::marking_cache_bytes },
+          { "card previews", trace_counter::preview_cache_bytes },
+          { "slot widgets", trace_counter::slot_widget_bytes } }
+    };
+    return list;
+}
+
+void append_row(
+    std::string& out, const char* label, std::int64_t bytes,
+    std::int64_t peak_bytes
+) {
+    char line[96];
+    std::snprintf(
+        line, sizeof(line), "  %-20s %12s %12s\n", label,
+        format_memory_bytes(bytes).c_str(),
+        format_memory_bytes(peak_bytes).c_str()
+    );
+    out += line;
+}
+} // namespace
+
+memory_account::memory_account(trace_counter counter)
+    : counter(counter)
+    , held(0) {
+    // Constructing the recorder first keeps it alive for the destructor of
+    // accounts owned by other function-local statics.
+    trace_recorder::instance();
+}
+
+memory_account::~memory_account() { set(0); }
+
+void memory_account::set(std::int64_t bytes) {
+    if (bytes == held) {
+        return;
+    }
+    trace_recorder::instance().add_to_counter(counter, bytes - held);
+    held = bytes;
+}
+
+std::int64_t memory_account::bytes() const { return held; }
+
+std::vector<memory_usage> memory_usage_by_subsystem() {
+    const trace_recorder& recorder = trace_recorder::instance();
+    std::vector<memory_usage> usage;
+    usage.reserve(subsystems().size());
+    for (const auto& [subsystem, counter] : subsystems()) {
+        usage.push_back({ subsystem, counter, recorder.counter(counter),
+                          recorder.counter_peak(counter) });
+    }
+    return usage;
+}
+
+std::string format_memory_bytes(std::int64_t bytes) {
+    constexpr std::array<const char*, 4> units { "B", "KiB", "MiB", "GiB" };
+    double value = static_cast<double>(bytes);
+    std::size_t unit = 0;
+    while ((value >= 1024.0 || value <= -1024.0) && unit + 1 < units.size()) {
+        value /= 1024.0;
+        ++unit;
+    }
+    char text[32];
+    if (unit == 0) {
+        std::snprintf(
+            text, sizeof(text), "%lld B", static_cast<long long>(bytes)
+        );
+    } else {
+        std::snprintf(text, sizeof(text), "%.1f %s", value, units[unit]);
+    }
+    return text;
+}
+
+std::string memory_report_text() {
+    char header[64];
+    std::snprintf(
+        header, sizeof(header), "%-22s %12s %12s\n", "Memory by subsystem",
+        "current", "peak"
+    );
+    std::string out = header;
+    std::int64_t total = 0;
+    for (const memory_usage& usage : memory_usage_by_subsystem()) {
+        append_row(out, usage.subsystem, usage.bytes, usage.peak_bytes);
+        total += usage.bytes;
+    }
+    // Subsystems peak at different times, so there is no total peak.
+    char line[64];
+    std::snprintf(
+        line, sizeof(line), "  %-20s %12s\n", "total",
+        format_memory_bytes(total).c_str()
+    );
+    out += line;
+    return out;
+}
@@ -0,0 +1,67 @@
+#include "helpers/preview_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+preview_cache::preview_cache()
+    : entries(default_budget_kb)
+    , memory(trace_counter::preview_cache_bytes) { }
+
+preview_cache& preview_cache::instance() {
+    static preview_cache cache;
+    return cache;
+}
+
+QSize preview_cache::bucket_size(const QSize& size) {
+    if (!size.isValid() || size.width() <= 0) {
+        return size;
+    }
+    const int width = (size.width() + size_bucket_px - 1) / size_bucket_px
+        * size_bucket_px;
+    const double scale
+        = static_cast<double>(width) / static_cast<double>(size.width());
+    const int height = std::max(
+        1, static_cast<int>(std::lround(size.height() * scale))
+    );
+    return QSize(width, height);
+}
+
+QString
+preview_cache::key_for(const QString& tag, int card_index, QSize size) {
+    size = bucket_size(size);
+    return QStringLiteral("%1|%2|%3x%4")
+        .arg(tag)
+        .arg(card_index)
+        .arg(size.width())
+        .arg(size.height());
+}
+
+QPixmap preview_cache::find(
+    const QString& tag, int card_index, const QSize& size
+) const {
+    const QPixmap* pixmap = entries.object(key_for(tag, card_index, size));
+    return pixmap != nullptr ? *pixmap : QPixmap();
+}
+
+void preview_cache::insert(
+    const QString& tag, int card_index, const QSize& size,
+    const QPixmap& pixmap
+) {
+    if (pixmap.isNull()) {
+        return;
+    }
+    const qsizetype cost_kb = std::max<qsizetype>(
+        1,
+        static_cast<qsizetype>(pixmap.width()) * pixmap.height()
+            * pixmap.depth() / 8 / 1024
+    );
+    entries.insert(
+        key_for(tag, card_index, size), new QPixmap(pixmap), cost_kb
+    );
+    memory.set(static_cast<qint64>(entries.totalCost()) * 1024);
+}
+
+void preview_cache::clear() {
+    entries.clear();
+    memory.set(0);
+}
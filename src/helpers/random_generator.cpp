@@ -1,14 +1,139 @@
 #include "helpers/random_generator.hpp"
 
+#include <atomic>
+#include <random>
+#include <utility>
+
+namespace {
+
+constexpr std::uint64_t kPcgMultiplier = 6364136223846793005ULL;
+
+std::uint64_t splitmix64(std::uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+std::uint64_t entropy_seed() {
+    std::random_device device;
+    const std::uint64_t high = device();
+    const std::uint64_t low = device();
+    return (high << 32) | low;
+}
+
+struct master_seed_state {
+    std::atomic<std::uint64_t> seed { entropy_seed() };
+    std::atomic<bool> fixed { false };
+    std::atomic<std::uint64_t> next_stream { 1 };
+};
+
+master_seed_state& master_state() {
+    static master_seed_state state;
+    return state;
+}
+
+}
+
 random_generator::random_generator()
-    : engine(std::random_device {}()) { }
+    : state(0)
+    , increment(0)
+    , seed_value(0)
+    , stream_value(0) {
+    master_seed_state& shared = master_state();
+    reseed(
+        shared.seed.load(std::memory_order_relaxed),
+        shared.next_stream.fetch_add(1, std::memory_order_relaxed)
+    );
+}
+
+random_generator::random_generator(std::uint64_t seed, std::uint64_t stream)
+    : state(0)
+    , increment(0)
+    , seed_value(0)
+    , stream_value(0) {
+    reseed(seed, stream);
+}
+
+void random_generator::set_master_seed(std::uint64_t seed) {
+    master_seed_state& shared = master_state();
+    shared.seed.store(seed, std::memory_order_relaxed);
+    shared.fixed.store(true, std::memory_order_relaxed);
+    shared.next_stream.store(1, std::memory_order_relaxed);
+}
+
+std::uint64_t random_generator::master_seed() {
+    return master_state().seed.load(std::memory_order_relaxed);
+}
+
+bool random_generator::has_fixed_master_seed() {
+    return master_state().fixed.load(std::memory_order_relaxed);
+}
+
+std::uint64_t
+random_generator::derive_seed(std::uint64_t seed, std::uint64_t index) {
+    return splitmix64(seed ^ splitmix64(index));
+}
+
+void random_generator::reseed(std::uint64_t seed, std::uint64_t stream) {
+    seed_value = seed;
+    stream_value = stream;
+    state = 0;
+    increment = (stream << 1u) | 1u;
+    (*this)();
+    state += seed;
+    (*this)();
+}
+
+random_generator random_generator::split(std::uint64_t index) const {
+    return random_generator(seed_value, derive_seed(stream_value, index));
+}
+
+std::uint64_t random_generator::seed() const { return seed_value; }
+
+std::uint64_t random_generator::stream() const { return stream_value; }
+
+random_generator::result_type random_generator::operator()() {
+    const std::uint64_t old_state = state;
+    state = old_state * kPcgMultiplier + increment;
+    const auto xorshifted
+        = static_cast<std::uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+    const auto rotation = static_cast<std::uint32_t>(old_state >> 59u);
+    return (xorshifted >> rotation) | (xorshifted << ((0u - rotation) & 31u));
+}
+
+std::uint32_t random_generator::bounded(std::uint32_t bound) {
+    if (bound == 0) {
+        return 0;
+    }
+
+    std::uint64_t product = std::uint64_t { (*this)() } * bound;
+    auto low = static_cast<std::uint32_t>(product);
+    if (low < bound) {
+        const std::uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = std::uint64_t { (*this)() } * bound;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32u);
+}
 
 int random_generator::uniform_int(int min, int max) {
-    std::uniform_int_distribution<int> dist(min, max);
-    return dist(engine);
+    if (max < min) {
+        std::swap(min, max);
+    }
+
+    const auto span = static_cast<std::uint32_t>(
+        static_cast<std::int64_t>(max) - static_cast<std::int64_t>(min) + 1
+    );
+    const std::uint32_t offset = span == 0 ? (*this)() : bounded(span);
+    return static_cast<int>(static_cast<std::int64_t>(min) + offset);
 }
 
 double random_generator::uniform_real(double min, double max) {
-    std::uniform_real_distribution<double> dist(min, max);
-    return dist(engine);
+    const std::uint64_t bits
+        = (std::uint64_t { (*this)() } << 32u) | (*this)();
+    const double unit = static_cast<double>(bits >> 11u) * 0x1.0p-53;
+    return min + (max - min) * unit;
 }
@@ -0,0 +1,297 @@
+#include "helpers/session_log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+constexpr std::array<std::uint8_t, 4> kMagic = { 'K', 'C', 'S', 'R' };
+
+void put_varint(std::vector<std::uint8_t>& buffer, std::uint64_t value) {
+    while (value >= 0x80u) {
+        buffer.push_back(static_cast<std::uint8_t>(value | 0x80u));
+        value >>= 7u;
+    }
+    buffer.push_back(static_cast<std::uint8_t>(value));
+}
+
+void put_signed(std::vector<std::uint8_t>& buffer, std::int64_t value) {
+    const auto bits = static_cast<std::uint64_t>(value);
+    put_varint(buffer, (bits << 1u) ^ (value < 0 ? ~std::uint64_t { 0 } : 0u));
+}
+
+class byte_reader {
+public:
+    explicit byte_reader(const std::vector<std::uint8_t>& bytes)
+        : data(bytes)
+        , position(0)
+        , failed(false) { }
+
+    bool at_end() const { return position >= data.size(); }
+    bool ok() const { return !failed; }
+
+    std::uint8_t byte() {
+        if (at_end()) {
+            failed = true;
+            return 0;
+        }
+        return data[position++];
+    }
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64u; shift += 7u) {
+            const std::uint8_t part = byte();
+            value |= std::uint64_t { part & 0x7Fu } << shift;
+            if ((part & 0x80u) == 0) {
+                return value;
+            }
+        }
+        failed = true;
+        return value;
+    }
+
+    std::int64_t signed_varint() {
+        const std::uint64_t bits = varint();
+        const auto magnitude = static_cast<std::int64_t>(bits >> 1u);
+        return (bits & 1u) != 0 ? -magnitude - 1 : magnitude;
+    }
+
+    int integer() { return static_cast<int>(signed_varint()); }
+
+private:
+    const std::vector<std::uint8_t>& data;
+    std::size_t position;
+    bool failed;
+};
+
+bool has_session_header(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    std::array<char, kMagic.size() + 1> start {};
+    if (!input.read(start.data(), static_cast<std::streamsize>(start.size()))) {
+        return false;
+    }
+    return std::equal(kMagic.begin(), kMagic.end(), start.begin())
+        && static_cast<std::uint8_t>(start.back())
+        == session_log::format_version;
+}
+
+}
+
+bool session_log::parse(const std::vector<std::uint8_t>& bytes, int session) {
+    header = session_header();
+    slot_setups.clear();
+    events.clear();
+    sessions_count = 0;
+
+    if (bytes.size() < kMagic.size() + 1
+        || !std::equal(kMagic.begin(), kMagic.end(), bytes.begin())) {
+        return false;
+    }
+
+    byte_reader reader(bytes);
+    for (std::size_t index = 0; index < kMagic.size(); ++index) {
+        reader.byte();
+    }
+    if (reader.byte() != format_version) {
+        return false;
+    }
+
+    // Records of the other sessions are still decoded to walk past them.
+    bool selected = false;
+    std::int64_t time_ms = 0;
+    while (!reader.at_end() && reader.ok()) {
+        const auto kind = static_cast<session_event_kind>(reader.byte());
+        time_ms += static_cast<std::int64_t>(reader.varint());
+
+        switch (kind) {
+        case session_event_kind::session_start: {
+            selected = session == last_session || sessions_count == session;
+            ++sessions_count;
+            session_header start;
+            start.seed = reader.varint();
+            start.quiz_type = reader.integer();
+            start.dealing_mode = reader.integer();
+            start.wait_for_answers = reader.byte() != 0;
+            if (selected) {
+                header = start;
+                slot_setups.clear();
+                events.clear();
+            }
+            time_ms = 0;
+            break;
+        }
+        case session_event_kind::slot_setup: {
+            session_slot_setup setup;
+            setup.slot = reader.integer();
+            setup.stream = reader.varint();
+            setup.cards_per_deck = reader.integer();
+            setup.decks_count = reader.integer();
+            setup.infinity = reader.byte() != 0;
+            const auto weights_count = reader.varint();
+            for (std::uint64_t index = 0; index < weights_count && reader.ok();
+                 ++index) {
+                setup.weights.push_back(reader.integer());
+            }
+            if (selected) {
+                slot_setups.push_back(std::move(setup));
+            }
+            break;
+        }
+        case session_event_kind::pick:
+        case session_event_kind::quiz_answer:
+        case session_event_kind::quiz_skip:
+        case session_event_kind::quiz_continue:
+        case session_event_kind::infinity_toggled:
+        case session_event_kind::paused:
+        case session_event_kind::game_over: {
+            session_event event;
+            event.kind = kind;
+            event.time_ms = time_ms;
+            event.slot = reader.integer();
+            event.value = reader.integer();
+            event.expected = reader.integer();
+            event.flag = reader.byte() != 0;
+            if (selected) {
+                events.push_back(event);
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    if (session != last_session && session >= sessions_count) {
+        return false;
+    }
+    return reader.ok();
+}
+
+bool session_log::read_from(const std::string& path, int session) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        return false;
+    }
+
+    const std::vector<std::uint8_t> bytes(
+        (std::istreambuf_iterator<char>(input)),
+        std::istreambuf_iterator<char>()
+    );
+    return parse(bytes, session);
+}
+
+std::int64_t session_log::duration_ms() const {
+    if (events.empty()) {
+        return 0;
+    }
+    return events.back().time_ms;
+}
+
+session_recorder::session_recorder(std::string path)
+    : file_path(std::move(path))
+    , buffer()
+    , current_time_ms(0)
+    , last_record_ms(0)
+    , recording(false) { }
+
+void session_recorder::begin_session(const session_header& header) {
+    buffer.clear();
+    current_time_ms = 0;
+    last_record_ms = 0;
+    recording = true;
+
+    write_record_start(session_event_kind::session_start);
+    put_varint(buffer, header.seed);
+    put_signed(buffer, header.quiz_type);
+    put_signed(buffer, header.dealing_mode);
+    buffer.push_back(header.wait_for_answers ? 1 : 0);
+}
+
+void session_recorder::add_slot(const session_slot_setup& setup) {
+    if (!recording) {
+        return;
+    }
+
+    write_record_start(session_event_kind::slot_setup);
+    put_signed(buffer, setup.slot);
+    put_varint(buffer, setup.stream);
+    put_signed(buffer, setup.cards_per_deck);
+    put_signed(buffer, setup.decks_count);
+    buffer.push_back(setup.infinity ? 1 : 0);
+    put_varint(buffer, setup.weights.size());
+    for (const int weight : setup.weights) {
+        put_signed(buffer, weight);
+    }
+}
+
+void session_recorder::set_time(std::int64_t time_ms) {
+    current_time_ms = time_ms;
+}
+
+void session_recorder::record(
+    session_event_kind kind, int slot, int value, int expected, bool flag
+) {
+    if (!recording) {
+        return;
+    }
+
+    write_record_start(kind);
+    put_signed(buffer, slot);
+    put_signed(buffer, value);
+    put_signed(buffer, expected);
+    buffer.push_back(flag ? 1 : 0);
+    if (kind == session_event_kind::game_over) {
+        recording = false;
+    }
+}
+
+bool session_recorder::save() {
+    if (buffer.empty() || file_path.empty()) {
+        return false;
+    }
+
+    const bool appending = has_session_header(file_path);
+    std::ofstream output(
+        file_path,
+        std::ios::binary | (appending ? std::ios::app : std::ios::trunc)
+    );
+    if (!output) {
+        return false;
+    }
+    if (!appending) {
+        output.write(
+            reinterpret_cast<const char*>(kMagic.data()),
+            static_cast<std::streamsize>(kMagic.size())
+        );
+        output.put(static_cast<char>(session_log::format_version));
+    }
+    output.write(
+        reinterpret_cast<const char*>(buffer.data()),
+        static_cast<std::streamsize>(buffer.size())
+    );
+    if (!output) {
+        return false;
+    }
+    buffer.clear();
+    return true;
+}
+
+bool session_recorder::is_recording() const { return recording; }
+
+const std::string& session_recorder::path() const { return file_path; }
+
+const std::vector<std::uint8_t>& session_recorder::bytes() const {
+    return buffer;
+}
+
+void session_recorder::write_record_start(session_event_kind kind) {
+    const std::int64_t delta = std::max<std::int64_t>(
+        0, current_time_ms - last_record_ms
+    );
+    last_record_ms = std::max(last_record_ms, current_time_ms);
+    buffer.push_back(static_cast<std::uint8_t>(kind));
+    put_varint(buffer, static_cast<std::uint64_t>(delta));
+}
@@ -0,0 +1,94 @@
+#include "helpers/session_replay.hpp"
+
+#include "card_helpers/shoe_bank.hpp"
+#include "model/slot_model.hpp"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+bool session_replay_result::matches() const {
+    return mismatched_picks == 0 && mismatched_answers == 0;
+}
+
+session_replay::session_replay(const session_log& recorded)
+    : log(recorded) { }
+
+session_replay_result session_replay::run() const {
+    const auto started = std::chrono::steady_clock::now();
+    session_replay_result result;
+    result.session_ms = log.duration_ms();
+
+    auto bank = std::make_shared<shoe_bank>();
+    std::vector<std::unique_ptr<slot_model>> slot_states;
+    for (const session_slot_setup& setup : log.slot_setups) {
+        if (setup.slot < 0) {
+            continue;
+        }
+        const auto index = static_cast<std::size_t>(setup.slot);
+        if (slot_states.size() <= index) {
+            slot_states.resize(index + 1);
+        }
+
+        auto slot = std::make_unique<slot_model>(bank);
+        slot->reseed(random_generator(log.header.seed, setup.stream).split(0));
+        slot->start(setup.cards_per_deck, setup.decks_count, setup.infinity);
+        slot->set_weights(
+            QVector<int>(setup.weights.begin(), setup.weights.end())
+        );
+        slot->set_paused(false);
+        slot_states[index] = std::move(slot);
+    }
+
+    for (const session_event& event : log.events) {
+        ++result.events;
+        if (event.slot < 0
+            || event.slot >= static_cast<int>(slot_states.size())
+            || slot_states[static_cast<std::size_t>(event.slot)] == nullptr) {
+            continue;
+        }
+
+        slot_model& slot = *slot_states[static_cast<std::size_t>(event.slot)];
+        switch (event.kind) {
+        case session_event_kind::pick:
+            ++result.picks;
+            if (!slot.deal() || slot.current_card_index() != event.value) {
+                ++result.mismatched_picks;
+            }
+            break;
+        case session_event_kind::quiz_answer:
+            ++result.answers;
+            if (slot.running_count() != event.expected) {
+                ++result.mismatched_answers;
+            }
+            slot.set_training(event.flag);
+            if (slot.submit_answer(event.value)
+                == slot_model::answer_outcome::correct) {
+                ++result.correct_answers;
+            }
+            break;
+        case session_event_kind::quiz_skip:
+            ++result.answers;
+            if (slot.running_count() != event.expected) {
+                ++result.mismatched_answers;
+            }
+            slot.set_training(event.flag);
+            slot.skip_question();
+            break;
+        case session_event_kind::quiz_continue:
+            slot.continue_quiz();
+            break;
+        case session_event_kind::infinity_toggled:
+            slot.set_infinity(event.value != 0);
+            break;
+        default:
+            break;
+        }
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    result.replay_us
+        = std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+              .count();
+    return result;
+}
@@ -0,0 +1,103 @@
+#include "helpers/slot_index_set.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+constexpr int kWordBits = 64;
+constexpr int kAbsent = -1;
+
+}
+
+slot_index_set::slot_index_set()
+    : members()
+    , positions()
+    , mask() { }
+
+void slot_index_set::resize(int capacity) {
+    capacity = std::max(0, capacity);
+    members.clear();
+    members.reserve(static_cast<std::size_t>(capacity));
+    positions.assign(static_cast<std::size_t>(capacity), kAbsent);
+    mask.assign(
+        static_cast<std::size_t>((capacity + kWordBits - 1) / kWordBits), 0
+    );
+}
+
+void slot_index_set::clear() {
+    for (int index : members) {
+        positions[static_cast<std::size_t>(index)] = kAbsent;
+    }
+    members.clear();
+    std::fill(mask.begin(), mask.end(), 0);
+}
+
+void slot_index_set::insert(int index) {
+    if (index < 0 || index >= static_cast<int>(positions.size())
+        || contains(index)) {
+        return;
+    }
+    positions[static_cast<std::size_t>(index)] = size();
+    members.push_back(index);
+    mask[static_cast<std::size_t>(index / kWordBits)]
+        |= std::uint64_t { 1 } << (index % kWordBits);
+}
+
+void slot_index_set::erase(int index) {
+    if (!contains(index)) {
+        return;
+    }
+    const int position = positions[static_cast<std::size_t>(index)];
+    const int last = members.back();
+    members[static_cast<std::size_t>(position)] = last;
+    positions[static_cast<std::size_t>(last)] = position;
+    members.pop_back();
+    positions[static_cast<std::size_t>(index)] = kAbsent;
+    mask[static_cast<std::size_t>(index / kWordBits)]
+        &= ~(std::uint64_t { 1 } << (index % kWordBits));
+}
+
+void slot_index_set::assign(int index, bool member) {
+    if (member) {
+        insert(index);
+    } else {
+        erase(index);
+    }
+}
+
+bool slot_index_set::contains(int index) const {
+    return index >= 0 && index < static_cast<int>(positions.size())
+        && positions[static_cast<std::size_t>(index)] != kAbsent;
+}
+
+bool slot_index_set::empty() const { return members.empty(); }
+
+int slot_index_set::size() const { return static_cast<int>(members.size()); }
+
+int slot_index_set::at(int position) const {
+    return members[static_cast<std::size_t>(position)];
+}
+
+int slot_index_set::next_from(int index) const {
+    if (members.empty()) {
+        return kAbsent;
+    }
+    const int capacity = static_cast<int>(positions.size());
+    index = (index >= 0 && index < capacity) ? index : 0;
+
+    const int words = static_cast<int>(mask.size());
+    const int first_word = index / kWordBits;
+    std::uint64_t bits = mask[static_cast<std::size_t>(first_word)]
+        & (~std::uint64_t { 0 } << (index % kWordBits));
+    for (int step = 0; step <= words; ++step) {
+        const int word = (first_word + step) % words;
+        if (step > 0) {
+            bits = mask[static_cast<std::size_t>(word)];
+        }
+        if (bits != 0) {
+            return word * kWordBits + std::countr_zero(bits);
+        }
+    }
+    return kAbsent;
+}
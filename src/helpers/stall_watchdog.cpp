@@ -0,0 +1,153 @@
+#include "helpers/stall_watchdog.hpp"
+
+#include "helpers/trace_recorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+constexpr std::int64_t kMinPollUs = 5000;
+constexpr const char* kUntrackedZone = "(outside instrumented zones)";
+} // namespace
+
+stall_watchdog& stall_watchdog::instance() {
+    static stall_watchdog watchdog;
+    return watchdog;
+}
+
+stall_watchdog::stall_watchdog()
+    : last_heartbeat_us(0)
+    , threshold_us(default_threshold_ms * 1000)
+    , worker()
+    , mutex()
+    , wake()
+    , stopping(false)
+    , zones()
+    , total_stalls(0)
+    , log()
+    , in_stall(false)
+    , stall_zone(nullptr)
+    , stall_start_us(0) { }
+
+stall_watchdog::~stall_watchdog() { stop(); }
+
+void stall_watchdog::start(
+    std::int64_t threshold_ms, const std::string& log_path
+) {
+    stop();
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        threshold_us = std::max<std::int64_t>(1, threshold_ms) * 1000;
+        stopping = false;
+        in_stall = false;
+        if (!log_path.empty()) {
+            log.open(log_path, std::ios::out | std::ios::app);
+        }
+    }
+    heartbeat();
+    worker = std::thread([this]() { run(); });
+}
+
+void stall_watchdog::stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (log.is_open()) {
+        log.close();
+    }
+}
+
+bool stall_watchdog::is_running() const { return worker.joinable(); }
+
+void stall_watchdog::heartbeat() {
+    last_heartbeat_us.store(
+        trace_recorder::instance().now_us(), std::memory_order_relaxed
+    );
+}
+
+std::int64_t stall_watchdog::threshold_ms() const {
+    const std::lock_guard<std::mutex> lock(mutex);
+    return threshold_us / 1000;
+}
+
+int stall_watchdog::stall_count() const {
+    const std::lock_guard<std::mutex> lock(mutex);
+    return total_stalls;
+}
+
+std::vector<stall_zone_count> stall_watchdog::stalls_by_zone() const {
+    std::vector<stall_zone_count> sorted;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        sorted = zones;
+    }
+    std::stable_sort(
+        sorted.begin(), sorted.end(),
+        [](const stall_zone_count& lhs, const stall_zone_count& rhs) {
+            return lhs.stalls > rhs.stalls;
+        }
+    );
+    return sorted;
+}
+
+void stall_watchdog::run() {
+    trace_recorder& recorder = trace_recorder::instance();
+    std::unique_lock<std::mutex> lock(mutex);
+    const auto poll
+        = std::chrono::microseconds(std::max(kMinPollUs, threshold_us / 4));
+    while (!stopping) {
+        wake.wait_for(lock, poll, [this]() { return stopping; });
+        if (stopping) {
+            break;
+        }
+        const std::int64_t last
+            = last_heartbeat_us.load(std::memory_order_relaxed);
+        const std::int64_t gap_us = recorder.now_us() - last;
+        if (!in_stall && gap_us > threshold_us) {
+            // Blame the zone the GUI thread is in while it is blocked.
+            in_stall = true;
+            stall_zone = recorder.active_zone();
+            stall_start_us = last;
+        } else if (in_stall && last != stall_start_us) {
+            finish_stall(last);
+        }
+    }
+}
+
+void stall_watchdog::finish_stall(std::int64_t end_us) {
+    in_stall = false;
+    const std::string zone
+        = stall_zone != nullptr ? stall_zone : kUntrackedZone;
+    const std::int64_t duration_us = end_us - stall_start_us;
+    const std::int64_t duration_ms = duration_us / 1000;
+
+    auto entry = std::find_if(
+        zones.begin(), zones.end(),
+        [&zone](const stall_zone_count& count) { return count.zone == zone; }
+    );
+    if (entry == zones.end()) {
+        zones.push_back({ zone, 0, 0 });
+        entry = zones.end() - 1;
+    }
+    ++entry->stalls;
+    entry->worst_ms = std::max(entry->worst_ms, duration_ms);
+    ++total_stalls;
+
+    trace_recorder& recorder = trace_recorder::instance();
+    recorder.add_to_counter(trace_counter::event_loop_stalls, 1);
+    if (recorder.is_enabled()) {
+        recorder.add_complete("stall", "watchdog", stall_start_us, duration_us);
+    }
+    if (log.is_open()) {
+        log << "stall " << duration_ms << " ms in " << zone << " at "
+            << stall_start_us / 1000 << " ms\n";
+        log.flush();
+    }
+}
@@ -0,0 +1,221 @@
+#include "helpers/startup_bootstrap.hpp"
+
+#include "helpers/str_label.hpp"
+#include "helpers/time_interface.hpp"
+
+#include <QEvent>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QWidget>
+#include <QtConcurrent>
+
+#include <utility>
+
+startup_bootstrap::startup_bootstrap(QObject* parent)
+    : QObject(parent)
+    , clock()
+    , stages()
+    , stage_index()
+    , milestones()
+    , finished_stages()
+    , first_frame_window(nullptr)
+    , running(false)
+    , playable_at_ms(-1) {
+    clock.start();
+}
+
+startup_bootstrap::~startup_bootstrap() {
+    if (first_frame_window != nullptr) {
+        first_frame_window->removeEventFilter(this);
+    }
+}
+
+void startup_bootstrap::add_stage(
+    const QString& name, const QStringList& dependencies, stage_thread thread,
+    std::function<void()> work
+) {
+    stage entry { name, QStringList(), thread, nullptr, -1, -1, false, false };
+    if (thread == stage_thread::pool) {
+        // Pool stages finish through their future watcher, not a callback.
+        entry.work = [work = std::move(work)](std::function<void()>) {
+            if (work) {
+                work();
+            }
+        };
+    } else {
+        entry.work = [work = std::move(work)](std::function<void()> done) {
+            if (work) {
+                work();
+            }
+            done();
+        };
+    }
+    for (const QString& dependency : dependencies) {
+        // Stages may only wait for stages added before them.
+        Q_ASSERT(stage_index.contains(dependency));
+        if (stage_index.contains(dependency)) {
+            entry.dependencies.append(dependency);
+        }
+    }
+    stage_index.insert(name, static_cast<int>(stages.size()));
+    stages.append(std::move(entry));
+    if (running) {
+        launch_ready_stages();
+    }
+}
+
+void startup_bootstrap::add_deferred_stage(
+    const QString& name, const QStringList& dependencies,
+    std::function<void(std::function<void()> done)> work
+) {
+    add_stage(name, dependencies, stage_thread::gui, nullptr);
+    stages.last().work = std::move(work);
+}
+
+void startup_bootstrap::start() {
+    if (running) {
+        return;
+    }
+    running = true;
+    launch_ready_stages();
+}
+
+void startup_bootstrap::watch_first_frame(QWidget* window) {
+    if (window == nullptr || milestones.contains(str_label("first_frame"))) {
+        return;
+    }
+    if (first_frame_window != nullptr) {
+        first_frame_window->removeEventFilter(this);
+    }
+    first_frame_window = window;
+    first_frame_window->installEventFilter(this);
+    QObject::connect(window, &QObject::destroyed, this, [this, window]() {
+        if (first_frame_window == window) {
+            first_frame_window = nullptr;
+        }
+    });
+}
+
+void startup_bootstrap::mark(const QString& milestone) {
+    if (!milestones.contains(milestone)) {
+        milestones.insert(milestone, elapsed_ms());
+    }
+}
+
+qint64 startup_bootstrap::milestone_ms(const QString& milestone) const {
+    return milestones.value(milestone, -1);
+}
+
+qint64 startup_bootstrap::elapsed_ms() const { return clock.elapsed(); }
+
+bool startup_bootstrap::is_finished() const { return playable_at_ms >= 0; }
+
+qint64 startup_bootstrap::playable_ms() const { return playable_at_ms; }
+
+const QVector<startup_bootstrap::stage_timing>&
+startup_bootstrap::timings() const {
+    return finished_stages;
+}
+
+QString startup_bootstrap::report() const {
+    QStringList lines;
+    lines.reserve(finished_stages.size() + 1);
+    for (const stage_timing& timing : finished_stages) {
+        lines.append(
+            str_label("startup stage=%1 thread=%2 ready_ms=%3 start_ms=%4 "
+                      "finish_ms=%5")
+                .arg(timing.name)
+                .arg(
+                    timing.thread == stage_thread::pool ? str_label("pool")
+                                                        : str_label("gui")
+                )
+                .arg(timing.ready_ms)
+                .arg(timing.start_ms)
+                .arg(timing.finish_ms)
+        );
+    }
+    lines.append(str_label("startup first_frame_ms=%1 playable_ms=%2")
+                     .arg(milestone_ms(str_label("first_frame")))
+                     .arg(playable_at_ms));
+    return lines.join(QLatin1Char('\n'));
+}
+
+bool startup_bootstrap::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == first_frame_window && event->type() == QEvent::Paint) {
+        mark(str_label("first_frame"));
+        first_frame_window->removeEventFilter(this);
+        first_frame_window = nullptr;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void startup_bootstrap::launch_ready_stages() {
+    for (int index = 0; index < stages.size(); ++index) {
+        stage& entry = stages[index];
+        if (entry.started || !dependencies_done(entry)) {
+            continue;
+        }
+        entry.started = true;
+        entry.ready_ms = elapsed_ms();
+        if (entry.thread == stage_thread::pool) {
+            run_stage(index);
+        } else {
+            time_interface::single_shot(0, this, [this, index]() {
+                run_stage(index);
+            });
+        }
+    }
+}
+
+bool startup_bootstrap::dependencies_done(const stage& entry) const {
+    for (const QString& dependency : entry.dependencies) {
+        if (!stages.at(stage_index.value(dependency)).done) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void startup_bootstrap::run_stage(int index) {
+    stages[index].start_ms = elapsed_ms();
+    if (stages[index].thread == stage_thread::pool) {
+        auto watcher = new QFutureWatcher<void>(this);
+        QObject::connect(
+            watcher, &QFutureWatcher<void>::finished, this,
+            [this, watcher, index]() {
+                watcher->deleteLater();
+                finish_stage(index);
+            }
+        );
+        watcher->setFuture(
+            QtConcurrent::run([work = stages[index].work]() { work({}); })
+        );
+        return;
+    }
+    // Copied: the stage may add stages and grow the vector while it runs.
+    const auto work = stages[index].work;
+    QPointer<startup_bootstrap> self(this);
+    work([self, index]() {
+        if (self != nullptr) {
+            self->finish_stage(index);
+        }
+    });
+}
+
+void startup_bootstrap::finish_stage(int index) {
+    stage& entry = stages[index];
+    if (entry.done) {
+        return;
+    }
+    entry.done = true;
+    const stage_timing timing { entry.name, entry.thread, entry.ready_ms,
+                                entry.start_ms, elapsed_ms() };
+    finished_stages.append(timing);
+    emit stage_finished(entry.name);
+
+    launch_ready_stages();
+    if (finished_stages.size() == stages.size() && playable_at_ms < 0) {
+        playable_at_ms = elapsed_ms();
+        emit finished();
+    }
+}
@@ -1,13 +1,97 @@
 #include "helpers/strategy_data.hpp"
 
 #include "helpers/str_label.hpp"
+#include "helpers/trace_recorder.hpp"
+#include "strategy_table.hpp"
 
+#include <QDir>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
 
 namespace {
+QString from_table(std::string_view text) {
+    return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+QVector<strategy_data> built_in_strategies() {
+    QVector<strategy_data> strategies;
+    strategies.reserve(static_cast<qsizetype>(strategy_table::entries.size()));
+
+    for (const strategy_table::entry& entry : strategy_table::entries) {
+        strategy_data data;
+        data.id = entry.id;
+        data.slug = from_table(entry.slug);
+        data.name = from_table(entry.name);
+        data.date = from_table(entry.date);
+        data.description = from_table(entry.description);
+        data.min_decks = entry.min_decks;
+        data.balance = entry.balance;
+        data.ace_neutral = entry.ace_neutral;
+        data.weights = QVector<int>(entry.weights.begin(), entry.weights.end());
+
+        for (int index = 0; index < entry.authors.count; ++index) {
+            data.authors.append(from_table(
+                strategy_table::authors[static_cast<std::size_t>(
+                    entry.authors.begin + index
+                )]
+            ));
+        }
+        for (int index = 0; index < entry.games.count; ++index) {
+            data.games.append(from_table(
+                strategy_table::games[static_cast<std::size_t>(
+                    entry.games.begin + index
+                )]
+            ));
+        }
+        for (int index = 0; index < entry.metrics.count; ++index) {
+            const strategy_table::metric& metric = strategy_table::metrics
+                [static_cast<std::size_t>(entry.metrics.begin + index)];
+            data.metrics.insert(from_table(metric.key), metric.value);
+        }
+        for (int index = 0; index < entry.unique_fields.count; ++index) {
+            const strategy_table::text_field& field
+                = strategy_table::unique_fields[static_cast<std::size_t>(
+                    entry.unique_fields.begin + index
+                )];
+            data.unique_fields.insert(
+                from_table(field.key), from_table(field.value)
+            );
+        }
+        for (int index = 0; index < entry.references.count; ++index) {
+            const strategy_table::reference& source
+                = strategy_table::references[static_cast<std::size_t>(
+                    entry.references.begin + index
+                )];
+            strategy_data::strategy_reference ref;
+            ref.type = from_table(source.type);
+            ref.citation = from_table(source.citation);
+            ref.url = from_table(source.url);
+            ref.accessed = from_table(source.accessed);
+            data.references.push_back(ref);
+        }
+
+        strategies.push_back(data);
+    }
+
+    return strategies;
+}
+
+QMap<QString, QString> built_in_key_descriptions() {
+    QMap<QString, QString> descriptions;
+    for (const strategy_table::text_field& field :
+         strategy_table::key_descriptions) {
+        descriptions.insert(from_table(field.key), from_table(field.value));
+    }
+    return descriptions;
+}
+
 QMap<QString, double> parse_metrics(const QJsonObject& metrics_object) {
     QMap<QString, double> metrics;
     for (auto it = metrics_object.begin(); it != metrics_object.end(); ++it) {
@@ -67,83 +151,227 @@ QMap<QString, QString> parse_key_descriptions(const QJsonObject& root) {
     }
     return descriptions;
 }
-} // namespace
-
-QVector<strategy_data> load_strategies() {
-    QFile file(str_label("assets/strategies.json"));
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return {};
-    }
 
-    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-    if (!doc.isObject()) {
-        return {};
-    }
-
-    const QJsonObject root = doc.object();
-    const QJsonArray strategies_array = root.value("strategies").toArray();
+QVector<strategy_data> parse_strategies(const QJsonArray& strategies_array) {
     QVector<strategy_data> strategies;
     strategies.reserve(strategies_array.size());
 
     for (const QJsonValue& value : strategies_array) {
-        if (!value.isObject()) {
-            continue;
-        }
-        const QJsonObject object = value.toObject();
         strategy_data data;
-        data.id = object.value("id").toInt();
-        data.slug = object.value("slug").toString();
-        data.name = object.value("name").toString();
-        data.date = object.value("date").toString();
-        data.description = object.value("description").toString();
-        data.min_decks = object.value("min_decks").toInt();
-        data.balance = object.value("balance").toBool();
-        data.ace_neutral = object.value("ace_neutral").toBool();
-
-        const QJsonArray authors = object.value("authors").toArray();
-        for (const QJsonValue& author : authors) {
-            data.authors.append(author.toString());
+        if (value.isObject() && parse_strategy(value.toObject(), data)) {
+            strategies.push_back(data);
         }
+    }
 
-        const QJsonArray games = object.value("games").toArray();
-        for (const QJsonValue& game : games) {
-            data.games.append(game.toString());
-        }
+    return strategies;
+}
 
-        if (object.contains("metrics") && object.value("metrics").isObject()) {
-            data.metrics = parse_metrics(object.value("metrics").toObject());
-        }
-        if (object.contains("weights") && object.value("weights").isArray()) {
-            data.weights = parse_weights(object.value("weights").toArray());
-        }
-        if (object.contains("unique_fields")
-            && object.value("unique_fields").isObject()) {
-            data.unique_fields
-                = parse_unique_fields(object.value("unique_fields").toObject());
-        }
-        if (object.contains("refs") && object.value("refs").isArray()) {
-            data.references = parse_references(object.value("refs").toArray());
-        }
+std::shared_ptr<const strategy_registry>& current_registry() {
+    static std::shared_ptr<const strategy_registry> registry;
+    return registry;
+}
+} // namespace
 
-        if (!data.name.isEmpty()) {
-            strategies.push_back(data);
+bool parse_strategy(const QJsonObject& object, strategy_data& data) {
+    data = strategy_data();
+    data.id = object.value("id").toInt();
+    data.slug = object.value("slug").toString();
+    data.name = object.value("name").toString();
+    data.date = object.value("date").toString();
+    data.description = object.value("description").toString();
+    data.min_decks = object.value("min_decks").toInt();
+    data.balance = object.value("balance").toBool();
+    data.ace_neutral = object.value("ace_neutral").toBool();
+
+    const QJsonArray authors = object.value("authors").toArray();
+    for (const QJsonValue& author : authors) {
+        data.authors.append(author.toString());
+    }
+
+    const QJsonArray games = object.value("games").toArray();
+    for (const QJsonValue& game : games) {
+        data.games.append(game.toString());
+    }
+
+    if (object.contains("metrics") && object.value("metrics").isObject()) {
+        data.metrics = parse_metrics(object.value("metrics").toObject());
+    }
+    if (object.contains("weights") && object.value("weights").isArray()) {
+        data.weights = parse_weights(object.value("weights").toArray());
+    }
+    if (object.contains("unique_fields")
+        && object.value("unique_fields").isObject()) {
+        data.unique_fields
+            = parse_unique_fields(object.value("unique_fields").toObject());
+    }
+    if (object.contains("refs") && object.value("refs").isArray()) {
+        data.references = parse_references(object.value("refs").toArray());
+    }
+
+    return !data.name.isEmpty();
+}
+
+strategy_registry::strategy_registry(
+    QVector<strategy_data> strategies, QMap<QString, QString> descriptions
+)
+    : entries(std::move(strategies))
+    , descriptions(std::move(descriptions))
+    , name_index()
+    , slug_index()
+    , id_index()
+    , matrix() {
+    for (int index = 0; index < entries.size(); ++index) {
+        const strategy_data& strategy = entries.at(index);
+        matrix.add_strategy(strategy.weights);
+        name_index.insert(strategy.name, index);
+        if (!strategy.slug.isEmpty()) {
+            slug_index.insert(strategy.slug, index);
         }
+        id_index.insert(strategy.id, index);
     }
+}
 
-    return strategies;
+std::shared_ptr<const strategy_registry> strategy_registry::instance() {
+    std::shared_ptr<const strategy_registry>& registry = current_registry();
+    if (registry == nullptr) {
+        registry = load();
+    }
+    return registry;
 }
 
-QMap<QString, QString> load_strategy_key_descriptions() {
-    QFile file(str_label("assets/strategies.json"));
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return {};
+std::shared_ptr<const strategy_registry> strategy_registry::load() {
+    const trace_zone zone("strategy_registry::load", "strategies");
+    QFile file(user_strategies_path());
+    if (!file.exists() || !file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return with_user_strategies(QByteArray());
     }
+    return with_user_strategies(file.readAll());
+}
 
-    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+void strategy_registry::set_instance(
+    std::shared_ptr<const strategy_registry> registry
+) {
+    current_registry() = std::move(registry);
+}
+
+std::shared_ptr<const strategy_registry>
+strategy_registry::with_user_strategies(const QByteArray& json) {
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
     if (!doc.isObject()) {
+        return with_user_strategies(QVector<strategy_data>());
+    }
+    return with_user_strategies(
+        parse_strategies(doc.object().value("strategies").toArray())
+    );
+}
+
+std::shared_ptr<const strategy_registry>
+strategy_registry::with_user_strategies(
+    const QVector<strategy_data>& user_strategies
+) {
+    QVector<strategy_data> strategies = built_in_strategies();
+    QMap<QString, QString> descriptions = built_in_key_descriptions();
+
+    for (const strategy_data& strategy : user_strategies) {
+        const bool taken = std::any_of(
+            strategies.cbegin(), strategies.cend(),
+            [&strategy](const strategy_data& existing) {
+                return existing.id == strategy.id
+                    || existing.name == strategy.name
+                    || (!strategy.slug.isEmpty()
+                        && existing.slug == strategy.slug);
+            }
+        );
+        if (!taken) {
+            strategies.push_back(strategy);
+        }
+    }
+
+    return std::shared_ptr<const strategy_registry>(
+        new strategy_registry(std::move(strategies), std::move(descriptions))
+    );
+}
+
+QString strategy_registry::user_strategies_path() {
+    const QString directory
+        = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return QDir(directory).filePath(str_label("strategies.json"));
+}
+
+std::shared_ptr<const strategy_registry>
+strategy_registry::from_json(const QByteArray& json) {
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    QVector<strategy_data> strategies;
+    QMap<QString, QString> descriptions;
+    if (doc.isObject()) {
+        const QJsonObject root = doc.object();
+        strategies = parse_strategies(root.value("strategies").toArray());
+        descriptions = parse_key_descriptions(root);
+    }
+    return std::shared_ptr<const strategy_registry>(
+        new strategy_registry(std::move(strategies), std::move(descriptions))
+    );
+}
+
+const QVector<strategy_data>& strategy_registry::strategies() const {
+    return entries;
+}
+
+const QMap<QString, QString>& strategy_registry::key_descriptions() const {
+    return descriptions;
+}
+
+const strategy_data*
+strategy_registry::find_by_name(const QString& name) const {
+    const auto it = name_index.constFind(name);
+    return it == name_index.constEnd() ? nullptr : &entries.at(it.value());
+}
+
+const strategy_data*
+strategy_registry::find_by_slug(const QString& slug) const {
+    const auto it = slug_index.constFind(slug);
+    return it == slug_index.constEnd() ? nullptr : &entries.at(it.value());
+}
+
+const strategy_data* strategy_registry::find_by_id(int id) const {
+    const auto it = id_index.constFind(id);
+    return it == id_index.constEnd() ? nullptr : &entries.at(it.value());
+}
+
+QVector<int> strategy_registry::weights_for_name(const QString& name) const {
+    const strategy_data* strategy = find_by_name(name);
+    if (strategy == nullptr) {
         return {};
     }
+    return strategy->weights;
+}
+
+const strategy_matrix& strategy_registry::weight_matrix() const {
+    return matrix;
+}
 
-    const QJsonObject root = doc.object();
-    return parse_key_descriptions(root);
+QStringList
+strategy_registry::changed_strategy_names(const strategy_registry& other
+) const {
+    QStringList changed;
+    for (const strategy_data& strategy : entries) {
+        const strategy_data* counterpart = other.find_by_name(strategy.name);
+        if (counterpart == nullptr || !(*counterpart == strategy)) {
+            changed.append(strategy.name);
+        }
+    }
+    for (const strategy_data& strategy : other.entries) {
+        if (find_by_name(strategy.name) == nullptr) {
+            changed.append(strategy.name);
+        }
+    }
+    return changed;
+}
+
+QVector<strategy_data> load_strategies() {
+    return strategy_registry::instance()->strategies();
+}
+
+QMap<QString, QString> load_strategy_key_descriptions() {
+    return strategy_registry::instance()->key_descriptions();
 }
@@ -0,0 +1,352 @@
+#include "helpers/strategy_simulator.hpp"
+
+#include "helpers/random_generator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kRanks
+    = static_cast<std::size_t>(strategy_simulator::ranks_count);
+constexpr std::size_t kFirstTen = 9;
+constexpr int kCardsPerRound = 5;
+constexpr int kCardsPerDeck = 52;
+constexpr std::uint64_t kProgressStep = 4096;
+constexpr std::uint64_t kCalibrationStream = 1;
+constexpr std::uint64_t kMainStream = 2;
+
+// Effects of removing one card of a rank from a single deck on the player's
+// advantage in percent (Griffin, The Theory of Blackjack), in
+// card_rank_order.
+constexpr std::array<double, kRanks> kBettingEffects
+    = { -0.61, 0.38, 0.44, 0.55,  0.69,  0.46, 0.28,
+        0.00,  -0.18, -0.51, -0.51, -0.51, -0.51 };
+
+struct decision {
+    std::array<bool, kRanks> deciding_ranks;
+    double break_even_density;
+};
+
+constexpr std::size_t kDecisions = 4;
+
+std::array<decision, kDecisions> playing_decisions() {
+    auto ranks_from = [](std::size_t first) {
+        std::array<bool, kRanks> ranks {};
+        std::fill(ranks.begin() + static_cast<std::ptrdiff_t>(first),
+                  ranks.end(), true);
+        return ranks;
+    };
+    std::array<bool, kRanks> tens_and_aces = ranks_from(kFirstTen);
+    tens_and_aces[0] = true;
+
+    return { {
+        // Stand 16 vs 10: any card from 6 up busts.
+        { ranks_from(5), 0.62 },
+        // Stand 12 vs 3: only ten-valued cards bust.
+        { ranks_from(kFirstTen), 0.325 },
+        // Double 11 vs A: ten-valued cards make 21.
+        { ranks_from(kFirstTen), 0.315 },
+        // Double 9 vs 2: tens and aces make 19 or 20.
+        { tens_and_aces, 0.40 },
+    } };
+}
+
+struct correlation_sums {
+    double count = 0.0;
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    double sum_xx = 0.0;
+    double sum_yy = 0.0;
+    double sum_xy = 0.0;
+
+    void add(double x, double y) {
+        count += 1.0;
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_yy += y * y;
+        sum_xy += x * y;
+    }
+
+    void merge(const correlation_sums& other) {
+        count += other.count;
+        sum_x += other.sum_x;
+        sum_y += other.sum_y;
+        sum_xx += other.sum_xx;
+        sum_yy += other.sum_yy;
+        sum_xy += other.sum_xy;
+    }
+
+    double covariance() const { return sum_xy - sum_x * sum_y / count; }
+    double variance_x() const { return sum_xx - sum_x * sum_x / count; }
+    double variance_y() const { return sum_yy - sum_y * sum_y / count; }
+
+    double correlation() const {
+        if (count < 2.0) {
+            return 0.0;
+        }
+        const double denominator = std::sqrt(variance_x() * variance_y());
+        return denominator > 0.0 ? covariance() / denominator : 0.0;
+    }
+
+    double slope() const {
+        const double variance = variance_x();
+        return count >= 2.0 && variance > 0.0 ? covariance() / variance : 0.0;
+    }
+
+    double intercept() const {
+        return count > 0.0 ? (sum_y - slope() * sum_x) / count : 0.0;
+    }
+};
+
+// Linear prediction of a decision's deviation gain from the true count.
+struct index_play {
+    double intercept = 0.0;
+    double slope = 0.0;
+
+    bool deviates(double true_count) const {
+        return intercept + slope * true_count > 0.0;
+    }
+};
+
+struct alignas(64) worker_totals {
+    correlation_sums betting;
+    correlation_sums insurance;
+    std::array<correlation_sums, kDecisions> deviation_fits;
+    double perfect_gain = 0.0;
+    double captured_gain = 0.0;
+    std::uint64_t rounds = 0;
+
+    void merge(const worker_totals& other) {
+        betting.merge(other.betting);
+        insurance.merge(other.insurance);
+        for (std::size_t index = 0; index < kDecisions; ++index) {
+            deviation_fits[index].merge(other.deviation_fits[index]);
+        }
+        perfect_gain += other.perfect_gain;
+        captured_gain += other.captured_gain;
+        rounds += other.rounds;
+    }
+};
+
+struct stage_setup {
+    std::array<int, kRanks> weights;
+    std::array<decision, kDecisions> decisions;
+    std::array<index_play, kDecisions> plays;
+    int decks_count;
+    double penetration;
+};
+
+class shoe_walker {
+public:
+    shoe_walker(const stage_setup& setup, random_generator generator)
+        : setup(setup)
+        , generator(generator)
+        , cards()
+        , remaining()
+        , position(0)
+        , cut_position(0)
+        , running_count(0)
+        , mean_weight(0.0) {
+        for (int deck = 0; deck < setup.decks_count; ++deck) {
+            for (std::size_t rank = 0; rank < kRanks; ++rank) {
+                for (int suit = 0; suit < 4; ++suit) {
+                    cards.push_back(static_cast<std::uint8_t>(rank));
+                }
+            }
+        }
+        const double cut = static_cast<double>(cards.size())
+            * std::clamp(setup.penetration, 0.1, 0.95);
+        cut_position = std::max(
+            kCardsPerRound, static_cast<int>(cut) - kCardsPerRound
+        );
+        for (const int weight : setup.weights) {
+            mean_weight += weight;
+        }
+        mean_weight /= static_cast<double>(kRanks);
+        shuffle();
+    }
+
+    void play_round(worker_totals& totals) {
+        if (position + kCardsPerRound > cut_position) {
+            shuffle();
+        }
+        for (int card = 0; card < kCardsPerRound; ++card) {
+            const std::size_t rank = cards[static_cast<std::size_t>(position)];
+            ++position;
+            --remaining[rank];
+            running_count += setup.weights[rank];
+        }
+        sample(totals);
+        ++totals.rounds;
+    }
+
+private:
+    void shuffle() {
+        generator.shuffle(cards.begin(), cards.end());
+        remaining.fill(4 * setup.decks_count);
+        position = 0;
+        running_count = 0;
+    }
+
+    void sample(worker_totals& totals) const {
+        const int cards_left = static_cast<int>(cards.size()) - position;
+        const double left = cards_left;
+        const double decks_left = left / kCardsPerDeck;
+        // Unbalanced counts drift by their mean weight per card; measuring
+        // against that drift compares all systems by their tags alone.
+        const double true_count
+            = (running_count - mean_weight * position) / decks_left;
+        const double expected_per_rank = left / static_cast<double>(kRanks);
+
+        double advantage = 0.0;
+        int tens_left = 0;
+        for (std::size_t rank = 0; rank < kRanks; ++rank) {
+            advantage += (expected_per_rank - remaining[rank])
+                * kBettingEffects[rank];
+            if (rank >= kFirstTen) {
+                tens_left += remaining[rank];
+            }
+        }
+        totals.betting.add(true_count, advantage / decks_left);
+        totals.insurance.add(true_count, 3.0 * tens_left / left - 1.0);
+
+        for (std::size_t index = 0; index < kDecisions; ++index) {
+            const decision& play = setup.decisions[index];
+            int deciding_left = 0;
+            int deciding_full = 0;
+            for (std::size_t rank = 0; rank < kRanks; ++rank) {
+                if (play.deciding_ranks[rank]) {
+                    deciding_left += remaining[rank];
+                    ++deciding_full;
+                }
+            }
+            const double full_density
+                = deciding_full / static_cast<double>(kRanks);
+            const double basic_side
+                = full_density > play.break_even_density ? 1.0 : -1.0;
+            const double gain = -basic_side
+                * (deciding_left / left - play.break_even_density);
+
+            totals.deviation_fits[index].add(true_count, gain);
+            totals.perfect_gain += std::max(0.0, gain);
+            if (setup.plays[index].deviates(true_count)) {
+                totals.captured_gain += gain;
+            }
+        }
+    }
+
+    const stage_setup& setup;
+    random_generator generator;
+    std::vector<std::uint8_t> cards;
+    std::array<int, kRanks> remaining;
+    int position;
+    int cut_position;
+    int running_count;
+    double mean_weight;
+};
+
+}
+
+strategy_simulator::strategy_simulator(simulation_settings settings)
+    : settings(settings)
+    , completed(0)
+    , cancelled(false) { }
+
+void strategy_simulator::cancel() {
+    cancelled.store(true, std::memory_order_relaxed);
+}
+
+std::uint64_t strategy_simulator::completed_rounds() const {
+    return completed.load(std::memory_order_relaxed);
+}
+
+std::uint64_t strategy_simulator::total_rounds() const {
+    return settings.rounds + std::max<std::uint64_t>(settings.rounds / 10, 1);
+}
+
+strategy_metrics strategy_simulator::run_weights(
+    const std::array<int, ranks_count>& weights
+) {
+    completed.store(0, std::memory_order_relaxed);
+    cancelled.store(false, std::memory_order_relaxed);
+
+    const std::uint64_t seed
+        = settings.seed != 0 ? settings.seed : random_generator::master_seed();
+    const auto hardware = static_cast<int>(std::thread::hardware_concurrency());
+    const int thread_count = std::max(
+        1, settings.threads > 0 ? settings.threads : hardware
+    );
+
+    stage_setup setup {
+        weights, playing_decisions(), {}, std::max(1, settings.decks_count),
+        settings.penetration
+    };
+
+    auto run_stage = [&](std::uint64_t rounds, std::uint64_t stream) {
+        std::vector<worker_totals> totals(
+            static_cast<std::size_t>(thread_count)
+        );
+        std::vector<std::thread> workers;
+        workers.reserve(totals.size());
+        const random_generator stage_generator(seed, stream);
+        const auto workers_count = static_cast<std::uint64_t>(thread_count);
+
+        for (std::size_t index = 0; index < totals.size(); ++index) {
+            const std::uint64_t share = rounds / workers_count
+                + (index < rounds % workers_count ? 1 : 0);
+            workers.emplace_back([&, index, share]() {
+                shoe_walker walker(setup, stage_generator.split(index));
+                worker_totals& local = totals[index];
+                for (std::uint64_t round = 0; round < share; ++round) {
+                    walker.play_round(local);
+                    if ((round + 1) % kProgressStep == 0) {
+                        completed.fetch_add(
+                            kProgressStep, std::memory_order_relaxed
+                        );
+                        if (cancelled.load(std::memory_order_relaxed)) {
+                            return;
+                        }
+                    }
+                }
+                completed.fetch_add(
+                    share % kProgressStep, std::memory_order_relaxed
+                );
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        worker_totals merged;
+        for (const worker_totals& local : totals) {
+            merged.merge(local);
+        }
+        return merged;
+    };
+
+    strategy_metrics metrics;
+    const worker_totals calibration = run_stage(
+        std::max<std::uint64_t>(settings.rounds / 10, 1), kCalibrationStream
+    );
+    for (std::size_t index = 0; index < kDecisions; ++index) {
+        setup.plays[index] = { calibration.deviation_fits[index].intercept(),
+                               calibration.deviation_fits[index].slope() };
+    }
+
+    const worker_totals totals = cancelled.load(std::memory_order_relaxed)
+        ? calibration
+        : run_stage(settings.rounds, kMainStream);
+
+    metrics.betting_correlation = totals.betting.correlation();
+    metrics.insurance_correlation = totals.insurance.correlation();
+    metrics.playing_efficiency = totals.perfect_gain > 0.0
+        ? std::max(0.0, totals.captured_gain / totals.perfect_gain)
+        : 0.0;
+    metrics.rounds = totals.rounds;
+    metrics.cancelled = cancelled.load(std::memory_order_relaxed);
+    return metrics;
+}
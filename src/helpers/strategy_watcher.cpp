@@ -0,0 +1,107 @@
+#include "helpers/strategy_watcher.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+#include <utility>
+
+namespace {
+
+constexpr int kReloadDelayMs = 150;
+
+QByteArray read_contents(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return {};
+    }
+    return file.readAll();
+}
+
+}
+
+strategy_watcher::strategy_watcher(QString path, QObject* parent)
+    : QObject(parent)
+    , file_path(std::move(path))
+    , watcher()
+    , reload_timer()
+    , last_contents(read_contents(file_path))
+    , parsed_cache() {
+    reload_timer.set_single_shot(true);
+    reload_timer.set_interval(kReloadDelayMs);
+    connect(&reload_timer, &time_interface::timeout, this, [this]() {
+        reload();
+    });
+
+    auto schedule_reload = [this](const QString&) { reload_timer.start(); };
+    connect(&watcher, &QFileSystemWatcher::fileChanged, this, schedule_reload);
+    connect(
+        &watcher, &QFileSystemWatcher::directoryChanged, this, schedule_reload
+    );
+    watch_paths();
+}
+
+const QString& strategy_watcher::path() const { return file_path; }
+
+void strategy_watcher::reload() {
+    watch_paths();
+
+    const QByteArray contents = read_contents(file_path);
+    if (contents == last_contents) {
+        return;
+    }
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(contents, &error);
+    if (!contents.trimmed().isEmpty()
+        && (error.error != QJsonParseError::NoError || !doc.isObject())) {
+        return;
+    }
+    last_contents = contents;
+
+    QVector<strategy_data> user_strategies;
+    QHash<QString, parsed_strategy> next_cache;
+    const QJsonArray strategies_array
+        = doc.object().value("strategies").toArray();
+    for (const QJsonValue& value : strategies_array) {
+        if (!value.isObject()) {
+            continue;
+        }
+        const QJsonObject object = value.toObject();
+        const QString name = object.value("name").toString();
+        const auto cached = parsed_cache.constFind(name);
+        parsed_strategy parsed { object, strategy_data() };
+        if (cached != parsed_cache.constEnd() && cached->source == object) {
+            parsed.data = cached->data;
+        } else if (!parse_strategy(object, parsed.data)) {
+            continue;
+        }
+        user_strategies.push_back(parsed.data);
+        next_cache.insert(name, std::move(parsed));
+    }
+    parsed_cache.swap(next_cache);
+
+    const std::shared_ptr<const strategy_registry> current
+        = strategy_registry::instance();
+    std::shared_ptr<const strategy_registry> next
+        = strategy_registry::with_user_strategies(user_strategies);
+    const QStringList changed = current->changed_strategy_names(*next);
+    if (changed.isEmpty()) {
+        return;
+    }
+    strategy_registry::set_instance(std::move(next));
+    emit strategies_changed(changed);
+}
+
+void strategy_watcher::watch_paths() {
+    const QString directory = QFileInfo(file_path).absolutePath();
+    if (!watcher.directories().contains(directory)
+        && QFileInfo::exists(directory)) {
+        watcher.addPath(directory);
+    }
+    if (!watcher.files().contains(file_path) && QFileInfo::exists(file_path)) {
+        watcher.addPath(file_path);
+    }
+}
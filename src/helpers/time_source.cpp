@@ -0,0 +1,252 @@
+#include "helpers/time_source.hpp"
+
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace {
+
+constexpr std::int64_t kNsPerMs = 1000000;
+
+std::shared_ptr<time_source>& current_source() {
+    static std::shared_ptr<time_source> source;
+    return source;
+}
+
+class system_timer : public time_source::timer {
+public:
+    explicit system_timer(std::function<void()> callback)
+        : qt_timer() {
+        QObject::connect(&qt_timer, &QTimer::timeout, std::move(callback));
+    }
+
+    void set_interval(int interval_ms) override {
+        qt_timer.setInterval(interval_ms);
+    }
+
+    int interval() const override { return qt_timer.interval(); }
+
+    void set_single_shot(bool single_shot) override {
+        qt_timer.setSingleShot(single_shot);
+    }
+
+    void set_precise(bool precise) override {
+        qt_timer.setTimerType(precise ? Qt::PreciseTimer : Qt::CoarseTimer);
+    }
+
+    void start() override { qt_timer.start(); }
+
+    void stop() override { qt_timer.stop(); }
+
+    bool is_active() const override { return qt_timer.isActive(); }
+
+private:
+    QTimer qt_timer;
+};
+} // namespace
+
+std::shared_ptr<time_source> time_source::instance() {
+    std::shared_ptr<time_source>& source = current_source();
+    if (source == nullptr) {
+        source = std::make_shared<system_time_source>();
+    }
+    return source;
+}
+
+void time_source::set_instance(std::shared_ptr<time_source> source) {
+    current_source() = std::move(source);
+}
+
+struct system_time_source::system_clock_state {
+    QElapsedTimer clock;
+};
+
+system_time_source::system_time_source()
+    : state(std::make_unique<system_clock_state>()) {
+    state->clock.start();
+}
+
+system_time_source::~system_time_source() = default;
+
+std::int64_t system_time_source::now_ns() const {
+    return state->clock.nsecsElapsed();
+}
+
+std::unique_ptr<time_source::timer>
+system_time_source::create_timer(std::function<void()> callback) {
+    return std::make_unique<system_timer>(std::move(callback));
+}
+
+void system_time_source::single_shot(
+    int interval_ms, QObject* context, std::function<void()> handler
+) {
+    QTimer::singleShot(interval_ms, context, std::move(handler));
+}
+
+class virtual_time_source::virtual_timer : public time_source::timer {
+public:
+    virtual_timer(virtual_time_source* owner, std::function<void()> callback)
+        : owner(owner)
+        , callback(std::move(callback))
+        , interval_ms(0)
+        , single_shot(false)
+        , active(false)
+        , deadline_ns(0)
+        , sequence(0) {
+        owner->timers.push_back(this);
+    }
+
+    ~virtual_timer() override {
+        if (owner != nullptr) {
+            std::erase(owner->timers, this);
+        }
+    }
+
+    void set_interval(int interval_ms) override {
+        this->interval_ms = std::max(0, interval_ms);
+        if (active) {
+            start();
+        }
+    }
+
+    int interval() const override { return interval_ms; }
+
+    void set_single_shot(bool single_shot) override {
+        this->single_shot = single_shot;
+    }
+
+    void set_precise(bool) override { }
+
+    void start() override {
+        if (owner == nullptr) {
+            return;
+        }
+        active = true;
+        deadline_ns = owner->current_ns + interval_ms * kNsPerMs;
+        sequence = owner->next_sequence++;
+    }
+
+    void stop() override { active = false; }
+
+    bool is_active() const override { return active; }
+
+    virtual_time_source* owner;
+    std::function<void()> callback;
+    int interval_ms;
+    bool single_shot;
+    bool active;
+    std::int64_t deadline_ns;
+    std::uint64_t sequence;
+};
+
+virtual_time_source::virtual_time_source()
+    : current_ns(0)
+    , next_sequence(0)
+    , timers()
+    , single_shots() { }
+
+virtual_time_source::~virtual_time_source() {
+    single_shots.clear();
+    for (virtual_timer* pending : timers) {
+        pending->owner = nullptr;
+        pending->active = false;
+    }
+}
+
+std::int64_t virtual_time_source::now_ns() const { return current_ns; }
+
+std::unique_ptr<time_source::timer>
+virtual_time_source::create_timer(std::function<void()> callback) {
+    return std::make_unique<virtual_timer>(this, std::move(callback));
+}
+
+void virtual_time_source::single_shot(
+    int interval_ms, QObject* context, std::function<void()> handler
+) {
+    auto shot = std::make_unique<virtual_timer>(this, std::function<void()>());
+    virtual_timer* fired = shot.get();
+    const QPointer<QObject> guard(context);
+    const bool has_context = context != nullptr;
+    fired->callback = [this, fired, guard, has_context, handler]() {
+        release_single_shot(fired);
+        if (!has_context || !guard.isNull()) {
+            handler();
+        }
+    };
+    fired->set_single_shot(true);
+    fired->set_interval(interval_ms);
+    fired->start();
+    single_shots.push_back(std::move(shot));
+}
+
+void virtual_time_source::advance_ms(std::int64_t delta_ms) {
+    const std::int64_t target_ns
+        = current_ns + std::max<std::int64_t>(0, delta_ms) * kNsPerMs;
+    while (virtual_timer* due = next_due(target_ns)) {
+        fire(due);
+    }
+    current_ns = target_ns;
+}
+
+bool virtual_time_source::run_next() {
+    virtual_timer* due = next_due(std::numeric_limits<std::int64_t>::max());
+    if (due == nullptr) {
+        return false;
+    }
+    fire(due);
+    return true;
+}
+
+std::size_t virtual_time_source::pending_timers() const {
+    return static_cast<std::size_t>(
+        std::count_if(timers.begin(), timers.end(), [](const auto* pending) {
+            return pending->active;
+        })
+    );
+}
+
+virtual_time_source::virtual_timer*
+virtual_time_source::next_due(std::int64_t limit_ns) const {
+    virtual_timer* due = nullptr;
+    for (virtual_timer* pending : timers) {
+        if (!pending->active || pending->deadline_ns > limit_ns) {
+            continue;
+        }
+        if (due == nullptr || pending->deadline_ns < due->deadline_ns
+            || (pending->deadline_ns == due->deadline_ns
+                && pending->sequence < due->sequence)) {
+            due = pending;
+        }
+    }
+    return due;
+}
+
+void virtual_time_source::fire(virtual_timer* due) {
+    current_ns = std::max(current_ns, due->deadline_ns);
+    if (due->single_shot) {
+        due->active = false;
+    } else {
+        due->deadline_ns += std::max(1, due->interval_ms) * kNsPerMs;
+        due->sequence = next_sequence++;
+    }
+    const std::function<void()> callback = due->callback;
+    if (callback) {
+        callback();
+    }
+}
+
+void virtual_time_source::release_single_shot(const timer* fired) {
+    const auto found = std::find_if(
+        single_shots.begin(), single_shots.end(),
+        [fired](const std::unique_ptr<timer>& shot) {
+            return shot.get() == fired;
+        }
+    );
+    if (found != single_shots.end()) {
+        single_shots.erase(found);
+    }
+}
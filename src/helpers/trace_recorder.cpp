@@ -0,0 +1,267 @@
+#include "helpers/trace_recorder.hpp"
+
+#include <fstream>
+
+namespace {
+void append_json_string(std::string& out, const char* text) {
+    out += '"';
+    for (const char* it = text; it != nullptr && *it != '\0'; ++it) {
+        const char c = *it;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+bool& tracked_thread_flag() {
+    thread_local bool tracked = false;
+    return tracked;
+}
+} // namespace
+
+trace_recorder& trace_recorder::instance() {
+    static trace_recorder recorder;
+    return recorder;
+}
+
+trace_recorder::trace_recorder()
+    : enabled(false)
+    , origin(std::chrono::steady_clock::now())
+    , mutex()
+    , events()
+    , counters()
+    , peaks()
+    , tracked_zone(nullptr) {
+    for (std::atomic<std::int64_t>& value : counters) {
+        value.store(0, std::memory_order_relaxed);
+    }
+    for (std::atomic<std::int64_t>& value : peaks) {
+        value.store(0, std::memory_order_relaxed);
+    }
+}
+
+void trace_recorder::enable() {
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void trace_recorder::disable() {
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+std::int64_t trace_recorder::now_us() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - origin
+    )
+        .count();
+}
+
+void trace_recorder::add_complete(
+    const char* name, const char* category, std::int64_t start_us,
+    std::int64_t duration_us
+) {
+    append({ name, category, 'X', start_us, duration_us, current_thread() });
+}
+
+void trace_recorder::add_instant(const char* name, const char* category) {
+    if (!is_enabled()) {
+        return;
+    }
+    append({ name, category, 'i', now_us(), 0, current_thread() });
+}
+
+void trace_recorder::add_to_counter(trace_counter counter, std::int64_t delta) {
+    std::atomic<std::int64_t>& value
+        = counters[static_cast<std::size_t>(counter)];
+    const std::int64_t updated
+        = value.fetch_add(delta, std::memory_order_relaxed) + delta;
+    raise_to(peaks[static_cast<std::size_t>(counter)], updated);
+    record_counter(counter, updated);
+}
+
+void trace_recorder::raise_counter(trace_counter counter, std::int64_t value) {
+    raise_to(counters[static_cast<std::size_t>(counter)], value);
+    raise_to(peaks[static_cast<std::size_t>(counter)], value);
+    record_counter(counter, value);
+}
+
+std::int64_t trace_recorder::counter(trace_counter counter) const {
+    return counters[static_cast<std::size_t>(counter)].load(
+        std::memory_order_relaxed
+    );
+}
+
+std::int64_t trace_recorder::counter_peak(trace_counter counter) const {
+    return peaks[static_cast<std::size_t>(counter)].load(
+        std::memory_order_relaxed
+    );
+}
+
+std::int64_t trace_recorder::take_counter(trace_counter counter) {
+    return counters[static_cast<std::size_t>(counter)].exchange(
+        0, std::memory_order_relaxed
+    );
+}
+
+void trace_recorder::track_zones() {
+    tracked_thread_flag() = true;
+}
+
+const char* trace_recorder::active_zone() const {
+    return tracked_zone.load(std::memory_order_relaxed);
+}
+
+std::size_t trace_recorder::event_count() const {
+    const std::lock_guard<std::mutex> lock(mutex);
+    return events.size();
+}
+
+void trace_recorder::clear() {
+    const std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+}
+
+std::string trace_recorder::to_json() const {
+    const std::lock_guard<std::mutex> lock(mutex);
+    std::string out;
+    out.reserve(64 + events.size() * 96);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (std::size_t index = 0; index < events.size(); ++index) {
+        const trace_event& event = events[index];
+        if (index > 0) {
+            out += ',';
+        }
+        out += "\n{\"name\":";
+        append_json_string(out, event.name);
+        out += ",\"cat\":";
+        append_json_string(out, event.category);
+        out += ",\"ph\":\"";
+        out += event.phase;
+        out += "\",\"ts\":";
+        out += std::to_string(event.start_us);
+        if (event.phase == 'X') {
+            out += ",\"dur\":";
+            out += std::to_string(event.duration_us);
+        } else if (event.phase == 'C') {
+            out += ",\"args\":{\"value\":";
+            out += std::to_string(event.duration_us);
+            out += '}';
+        } else {
+            out += ",\"s\":\"t\"";
+        }
+        out += ",\"pid\":1,\"tid\":";
+        out += std::to_string(event.thread);
+        out += '}';
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+bool trace_recorder::write_to(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    const std::string json = to_json();
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+    return static_cast<bool>(file);
+}
+
+std::uint32_t trace_recorder::current_thread() {
+    static std::atomic<std::uint32_t> next_thread { 1 };
+    thread_local const std::uint32_t thread
+        = next_thread.fetch_add(1, std::memory_order_relaxed);
+    return thread;
+}
+
+const char* trace_recorder::counter_name(trace_counter counter) {
+    switch (counter) {
+    case trace_counter::raster_jobs_pending:
+        return "raster_jobs_pending";
+    case trace_counter::raster_jobs_active:
+        return "raster_jobs_active";
+    case trace_counter::card_raster_bytes:
+        return "card_raster_bytes";
+    case trace_counter::scaled_face_bytes:
+        return "scaled_face_bytes";
+    case trace_counter::marking_cache_bytes:
+        return "marking_cache_bytes";
+    case trace_counter::preview_cache_bytes:
+        return "preview_cache_bytes";
+    case trace_counter::slot_widget_bytes:
+        return "slot_widget_bytes";
+    case trace_counter::deal_jitter_us:
+        return "deal_jitter_us";
+    case trace_counter::event_loop_stalls:
+        return "event_loop_stalls";
+    }
+    return "counter";
+}
+
+bool trace_recorder::is_tracked_thread() { return tracked_thread_flag(); }
+
+void trace_recorder::raise_to(
+    std::atomic<std::int64_t>& value, std::int64_t to
+) {
+    std::int64_t seen = value.load(std::memory_order_relaxed);
+    while (seen < to
+           && !value.compare_exchange_weak(
+               seen, to, std::memory_order_relaxed
+           )) { }
+}
+
+const char* trace_recorder::enter_zone(const char* name) {
+    return tracked_zone.exchange(name, std::memory_order_relaxed);
+}
+
+void trace_recorder::leave_zone(const char* previous) {
+    tracked_zone.store(previous, std::memory_order_relaxed);
+}
+
+void trace_recorder::record_counter(trace_counter counter, std::int64_t value) {
+    if (!is_enabled()) {
+        return;
+    }
+    append({ counter_name(counter), "counter", 'C', now_us(), value,
+             current_thread() });
+}
+
+void trace_recorder::append(const trace_event& event) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (events.size() >= max_events) {
+        return;
+    }
+    events.push_back(event);
+}
+
+trace_zone::trace_zone(const char* name, const char* category)
+    : name(name)
+    , category(category)
+    , previous_zone(
+          trace_recorder::is_tracked_thread()
+              ? trace_recorder::instance().enter_zone(name)
+              : nullptr
+      )
+    , start_us(
+          trace_recorder::instance().is_enabled()
+              ? trace_recorder::instance().now_us()
+              : -1
+      ) { }
+
+trace_zone::~trace_zone() {
+    trace_recorder& recorder = trace_recorder::instance();
+    if (trace_recorder::is_tracked_thread()) {
+        recorder.leave_zone(previous_zone);
+    }
+    if (start_us < 0) {
+        return;
+    }
+    recorder.add_complete(
+        name, category, start_us, recorder.now_us() - start_us
+    );
+}
@@ -1,21 +1,109 @@
 #include <QApplication>
+#include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QIcon>
+#include <cstdio>
 #include <memory>
+#include <string_view>
 
 #include "main_window.hpp"
 
+#include "card_helpers/card_sheet.hpp"
+#include "helpers/memory_report.hpp"
+#include "helpers/random_generator.hpp"
+#include "helpers/session_log.hpp"
+#include "helpers/session_replay.hpp"
+#include "helpers/stall_watchdog.hpp"
+#include "helpers/startup_bootstrap.hpp"
 #include "helpers/str_label.hpp"
+#include "helpers/strategy_data.hpp"
+#include "helpers/time_interface.hpp"
+#include "helpers/trace_recorder.hpp"
 
 #ifdef KC_KDE
 #include <KAboutData>
 #include <KLocalizedString>
 #endif
 
+namespace {
+// Options are parsed only once the application exists, but a headless
+// replay must not need a display, so it is recognised from argv first.
+bool is_headless_replay(int argc, char* argv[]) {
+    bool headless = false;
+    bool replay = false;
+    for (int index = 1; index < argc; ++index) {
+        const std::string_view argument(argv[index]);
+        if (argument == "--") {
+            break;
+        }
+        headless = headless || argument == "--headless";
+        replay = replay || argument == "--replay"
+            || argument.substr(0, 9) == "--replay=";
+    }
+    return headless && replay;
+}
+} // namespace
+
 int main(int argc, char* argv[]) {
-    QApplication app(argc, argv);
-    app.setWindowIcon(QIcon(str_label("assets/favicon.ico")));
+    startup_bootstrap bootstrap;
+    const bool headless_replay = is_headless_replay(argc, argv);
+    std::unique_ptr<QCoreApplication> app;
+    if (headless_replay) {
+        app = std::make_unique<QCoreApplication>(argc, argv);
+    } else {
+        app = std::make_unique<QApplication>(argc, argv);
+        QApplication::setWindowIcon(QIcon(str_label("assets/favicon.ico")));
+    }
+
+    const QCommandLineOption seed_option(
+        str_label("seed"),
+        str_label("Master seed for shuffles and dealing (reproducible runs)."),
+        str_label("seed")
+    );
+    const QCommandLineOption record_option(
+        str_label("record"),
+        str_label("Append each session to <file>; the session in progress is "
+                  "saved on exit."),
+        str_label("file")
+    );
+    const QCommandLineOption replay_option(
+        str_label("replay"),
+        str_label("Replay the last session recorded in <file>."),
+        str_label("file")
+    );
+    const QCommandLineOption replay_session_option(
+        str_label("replay-session"),
+        str_label("With --replay: replay session <index> of the file, "
+                  "counting from 0."),
+        str_label("index")
+    );
+    const QCommandLineOption headless_option(
+        str_label("headless"),
+        str_label("With --replay: re-deal at full speed without a window and "
+                  "print the result.")
+    );
+    const QCommandLineOption startup_profile_option(
+        str_label("startup-profile"),
+        str_label("Print startup stage timings, time to first frame and time "
+                  "to playable.")
+    );
+    const QCommandLineOption trace_option(
+        str_label("trace"),
+        str_label("Write a Chrome trace of raster jobs, paints, deals and "
+                  "quizzes to <file> (opens in Perfetto)."),
+        str_label("file")
+    );
+    const QCommandLineOption stall_log_option(
+        str_label("stall-log"),
+        str_label("Append a line for every event-loop stall to <file>."),
+        str_label("file")
+    );
+    const QCommandLineOption mem_report_option(
+        str_label("mem-report"),
+        str_label("On exit, print the memory held by card rasters, scaled "
+                  "faces, table markings, previews and slot widgets.")
+    );
 
 #ifdef KC_KDE
     KLocalizedString::setApplicationDomain("kcuckounter");
@@ -38,7 +126,16 @@ int main(int argc, char* argv[]) {
 
     QCommandLineParser parser;
     about_data.setupCommandLine(&parser);
-    parser.process(app);
+    parser.addOption(seed_option);
+    parser.addOption(record_option);
+    parser.addOption(replay_option);
+    parser.addOption(replay_session_option);
+    parser.addOption(headless_option);
+    parser.addOption(startup_profile_option);
+    parser.addOption(trace_option);
+    parser.addOption(stall_log_option);
+    parser.addOption(mem_report_option);
+    parser.process(*app);
     about_data.processCommandLine(&parser);
 #else
     QCoreApplication::setApplicationName(str_label("kcuckounter"));
@@ -51,13 +148,185 @@ int main(int argc, char* argv[]) {
     );
     parser.addHelpOption();
     parser.addVersionOption();
-    parser.process(app);
+    parser.addOption(seed_option);
+    parser.addOption(record_option);
+    parser.addOption(replay_option);
+    parser.addOption(replay_session_option);
+    parser.addOption(headless_option);
+    parser.addOption(startup_profile_option);
+    parser.addOption(trace_option);
+    parser.addOption(stall_log_option);
+    parser.addOption(mem_report_option);
+    parser.process(*app);
 #endif
 
-    auto window = std::make_unique<main_window>();
-    window->show();
+    if (parser.isSet(seed_option)) {
+        bool seed_ok = false;
+        const qulonglong seed = parser.value(seed_option).toULongLong(&seed_ok);
+        if (!seed_ok) {
+            std::fputs(
+                qPrintable(str_label("Invalid value for --seed: %1\n")
+                               .arg(parser.value(seed_option))),
+                stderr
+            );
+            return 1;
+        }
+        random_generator::set_master_seed(seed);
+    }
+
+    if (parser.isSet(trace_option)) {
+        trace_recorder::instance().enable();
+    }
+    const auto save_trace = [&parser, &trace_option]() {
+        if (!parser.isSet(trace_option)) {
+            return true;
+        }
+        const QString trace_path = parser.value(trace_option);
+        if (trace_recorder::instance().write_to(trace_path.toStdString())) {
+            return true;
+        }
+        std::fputs(
+            qPrintable(str_label("Cannot write trace: %1\n").arg(trace_path)),
+            stderr
+        );
+        return false;
+    };
+
+    std::shared_ptr<session_log> replay_log;
+    if (parser.isSet(replay_option)) {
+        replay_log = std::make_shared<session_log>();
+        const QString replay_path = parser.value(replay_option);
+        bool session_ok = true;
+        const int session = parser.isSet(replay_session_option)
+            ? parser.value(replay_session_option).toInt(&session_ok)
+            : session_log::last_session;
+        if (!session_ok || session < session_log::last_session) {
+            std::fputs(
+                qPrintable(str_label("Invalid value for --replay-session: %1\n")
+                               .arg(parser.value(replay_session_option))),
+                stderr
+            );
+            return 1;
+        }
+        if (!replay_log->read_from(replay_path.toStdString(), session)) {
+            std::fputs(
+                qPrintable(str_label("Cannot read session log: %1\n")
+                               .arg(replay_path)),
+                stderr
+            );
+            return 1;
+        }
+        if (parser.isSet(headless_option)) {
+            const session_replay_result replay_result
+                = session_replay(*replay_log).run();
+            std::printf(
+                "events=%d picks=%d mismatched_picks=%d answers=%d "
+                "correct_answers=%d mismatched_answers=%d session_ms=%lld "
+                "replay_us=%lld\n",
+                replay_result.events, replay_result.picks,
+                replay_result.mismatched_picks, replay_result.answers,
+                replay_result.correct_answers,
+                replay_result.mismatched_answers,
+                static_cast<long long>(replay_result.session_ms),
+                static_cast<long long>(replay_result.replay_us)
+            );
+            save_trace();
+            return replay_result.matches() ? 0 : 2;
+        }
+    }
+    if (headless_replay) {
+        // The scan saw the flags, but the parser read them as option values.
+        std::fputs(
+            qPrintable(str_label("--headless needs --replay <file>\n")),
+            stderr
+        );
+        return 1;
+    }
+
+    // Stalls are only watched when they are logged or traced; otherwise the
+    // performance HUD runs the watchdog while it is shown. The watchdog
+    // blames stalls on the zone the GUI thread is in, so zones are tracked
+    // on this thread; heartbeats come at half the threshold.
+    stall_watchdog& watchdog = stall_watchdog::instance();
+    time_interface heartbeat_timer;
+    heartbeat_timer.set_interval(
+        static_cast<int>(stall_watchdog::default_threshold_ms / 2)
+    );
+    QObject::connect(
+        &heartbeat_timer, &time_interface::timeout,
+        [&watchdog]() { watchdog.heartbeat(); }
+    );
+    if (parser.isSet(stall_log_option) || parser.isSet(trace_option)) {
+        trace_recorder::instance().track_zones();
+        watchdog.start(
+            stall_watchdog::default_threshold_ms,
+            parser.value(stall_log_option).toStdString()
+        );
+        heartbeat_timer.start();
+    }
+
+    // The window is shown first; the card sheet and the strategy registry
+    // load on the thread pool meanwhile, and the table is populated and
+    // rasterized once both are ready.
+    std::unique_ptr<main_window> window;
+    std::shared_ptr<const strategy_registry> loaded_strategies;
+    bootstrap.add_stage(
+        str_label("window"), {}, startup_bootstrap::stage_thread::gui,
+        [&]() {
+            window = std::make_unique<main_window>();
+            if (parser.isSet(record_option)) {
+                window->record_sessions_to(parser.value(record_option));
+            }
+            bootstrap.watch_first_frame(window.get());
+            window->show();
+        }
+    );
+    bootstrap.add_stage(
+        str_label("card_sheet"), {}, startup_bootstrap::stage_thread::pool,
+        []() { preload_card_sheet(); }
+    );
+    bootstrap.add_stage(
+        str_label("strategies"), {}, startup_bootstrap::stage_thread::pool,
+        [&loaded_strategies]() {
+            loaded_strategies = strategy_registry::load();
+        }
+    );
+    bootstrap.add_stage(
+        str_label("table"),
+        { str_label("window"), str_label("card_sheet"),
+          str_label("strategies") },
+        startup_bootstrap::stage_thread::gui,
+        [&]() {
+            strategy_registry::set_instance(std::move(loaded_strategies));
+            window->populate_table();
+        }
+    );
+    bootstrap.add_deferred_stage(
+        str_label("cards"), { str_label("table") },
+        [&window](std::function<void()> done) {
+            window->prepare_initial_cards(std::move(done));
+        }
+    );
+    QObject::connect(&bootstrap, &startup_bootstrap::finished, [&]() {
+        if (parser.isSet(startup_profile_option)) {
+            std::fprintf(stderr, "%s\n", qPrintable(bootstrap.report()));
+        }
+        if (replay_log != nullptr) {
+            window->start_replay(replay_log);
+        }
+    });
+    bootstrap.start();
 
     int result = QApplication::exec();
+    heartbeat_timer.stop();
+    watchdog.stop();
+    // Printed while the window still holds its caches; peaks cover the run.
+    if (parser.isSet(mem_report_option)) {
+        std::fputs(memory_report_text().c_str(), stderr);
+    }
     window.reset();
+    if (!save_trace() && result == 0) {
+        result = 1;
+    }
     return result;
 }
@@ -4,12 +4,16 @@
 #include "widget/table.hpp"
 
 #include "helpers/icon_loader.hpp"
+#include "helpers/memory_report.hpp"
+#include "helpers/session_log.hpp"
 #include "helpers/str_label.hpp"
+#include "helpers/strategy_watcher.hpp"
 
 #include <QAbstractButton>
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QLabel>
+#include <QMenu>
 #include <QMessageBox>
 #include <QProgressBar>
 #include <QSlider>
@@ -17,8 +21,10 @@
 #include <QStringList>
 #include <QTabWidget>
 #include <QToolBar>
+#include <QToolButton>
 
 #include <algorithm>
+#include <utility>
 
 main_window::main_window(BaseWidget* parent)
     : BaseMainWindow(parent)
@@ -27,10 +33,15 @@ main_window::main_window(BaseWidget* parent)
     , wait_for_answers(nullptr)
     , allow_skipping(nullptr)
     , dealing_mode(nullptr)
+    , late_picks(nullptr)
     , continue_button(nullptr)
     , table_widget(nullptr)
+    , strategies_watcher(nullptr)
     , setup_dialog(nullptr)
     , setup_widget(nullptr)
+    , settings_dialog(nullptr)
+    , appearance_settings(nullptr)
+    , settings_dialog_stale(false)
     , clock_timer(nullptr)
     , clock_label(nullptr)
     , status_label(nullptr)
@@ -47,12 +58,49 @@ main_window::main_window(BaseWidget* parent)
     , rasterization_busy(false)
     , pending_start_after_rasterization(false)
     , score_correct(0)
-    , score_total(0) {
+    , score_total(0)
+    , pending_replay() {
     setup_ui();
 }
 
 main_window::~main_window() = default;
 
+void main_window::record_sessions_to(const QString& path) {
+    if (table_widget == nullptr) {
+        return;
+    }
+    table_widget->set_session_recorder(
+        std::make_shared<session_recorder>(path.toStdString())
+    );
+}
+
+void main_window::start_replay(std::shared_ptr<const session_log> log) {
+    if (log == nullptr || table_widget == nullptr) {
+        return;
+    }
+
+    pending_replay = std::move(log);
+    if (table_slots_count != nullptr) {
+        table_slots_count->setValue(
+            static_cast<int>(pending_replay->slot_setups.size())
+        );
+    }
+    if (quiz_type != nullptr) {
+        quiz_type->setCurrentIndex(pending_replay->header.quiz_type);
+    }
+    if (dealing_mode != nullptr) {
+        dealing_mode->setCurrentIndex(pending_replay->header.dealing_mode);
+    }
+    if (wait_for_answers != nullptr) {
+        wait_for_answers->setChecked(false);
+    }
+
+    time_interface::single_shot(0, this, [this]() {
+        on_continue_button_clicked();
+        on_start_pause_triggered();
+    });
+}
+
 void main_window::setup_ui() {
     auto toolbar = new BaseToolBar(str_label("Main"), this);
     toolbar->setToolButtonStyle(Qt::ToolButtonTextBesideIcon);
@@ -152,11 +200,21 @@ void main_window::setup_ui() {
                       << str_label("Simultaneous")
     );
 
+    late_picks = new BaseComboBox(setup_widget);
+    late_picks->addItems(
+        QStringList() << str_label("Drop") << str_label("Burst")
+                      << str_label("Stretch")
+    );
+    late_picks->setToolTip(
+        str_label("What happens to picks that are due while the app is busy")
+    );
+
     form_layout->addRow(str_label("Table slots"), table_slots_count);
     form_layout->addRow(str_label("Quiz mode"), quiz_type);
     form_layout->addRow(wait_for_answers);
     form_layout->addRow(allow_skipping);
     form_layout->addRow(str_label("Dealing mode"), dealing_mode);
+    form_layout->addRow(str_label("Late picks"), late_picks);
 
     continue_button = new BasePushButton(setup_widget);
     continue_button->setText(str_label("Continue"));
@@ -194,7 +252,7 @@ void main_window::setup_ui() {
         window_status_bar->addPermanentWidget(pickup_interval_label);
 
         speed_slider = new QSlider(Qt::Horizontal, this);
-        speed_slider->setRange(100, 1000);
+        speed_slider->setRange(16, 1000);
         speed_slider->setValue(300);
         speed_slider->setToolTip(str_label("Card pickup interval (ms)"));
         window_status_bar->addPermanentWidget(speed_slider);
@@ -256,6 +314,49 @@ void main_window::setup_ui() {
     if (table_widget != nullptr && speed_slider != nullptr) {
         table_widget->set_pick_interval(speed_slider->value());
     }
+    if (table_widget != nullptr) {
+        auto debug_menu = new QMenu(str_label("Debug"), this);
+        auto hud_action = debug_menu->addAction(str_label("Performance HUD"));
+        hud_action->setCheckable(true);
+        hud_action->setShortcut(QKeySequence(Qt::Key_F3));
+        addAction(hud_action);
+        QObject::connect(
+            hud_action, &BaseAction::toggled, table_widget,
+            &table::set_perf_hud_visible
+        );
+        auto memory_action = debug_menu->addAction(str_label("Memory report"));
+        QObject::connect(
+            memory_action, &BaseAction::triggered, this,
+            &main_window::show_memory_report
+        );
+
+        auto debug_action = toolbar->addAction(str_label("Debug"));
+        debug_action->setIcon(
+            icon_loader::themed(
+                { "tools-report-bug", "debug-run", "utilities-system-monitor" },
+                QStyle::SP_MessageBoxInformation
+            )
+        );
+        debug_action->setMenu(debug_menu);
+        auto debug_button = qobject_cast<QToolButton*>(
+            toolbar->widgetForAction(debug_action)
+        );
+        if (debug_button != nullptr) {
+            debug_button->setPopupMode(QToolButton::InstantPopup);
+        }
+    }
+
+    strategies_watcher = new strategy_watcher(
+        strategy_registry::user_strategies_path(), this
+    );
+    QObject::connect(
+        strategies_watcher, &strategy_watcher::strategies_changed,
+        table_widget, &table::apply_strategy_changes
+    );
+    QObject::connect(
+        strategies_watcher, &strategy_watcher::strategies_changed, this,
+        &main_window::discard_settings_dialog
+    );
 
     setWindowTitle(str_label("kcuckounter"));
 
@@ -293,6 +394,19 @@ void main_window::setup_ui() {
         }
     }
 
+    if (late_picks != nullptr) {
+        QObject::connect(
+            late_picks, &BaseComboBox::currentIndexChanged, this,
+            [this](int index) {
+                if (table_widget != nullptr) {
+                    table_widget->set_catch_up_policy(
+                        static_cast<catch_up_policy>(index)
+                    );
+                }
+            }
+        );
+    }
+
     if (quiz_type != nullptr && wait_for_answers != nullptr) {
         QObject::connect(
             quiz_type, &BaseComboBox::currentIndexChanged, this,
@@ -323,12 +437,6 @@ void main_window::setup_ui() {
         );
     }
 
-    if (table_widget != nullptr && table_slots_count != nullptr) {
-        table_widget->set_slot_count(table_slots_count->value());
-        table_widget->show();
-        table_widget->schedule_card_preload();
-    }
-
     if (pickup_interval_label != nullptr && speed_slider != nullptr) {
         pickup_interval_label->setText(
             str_label("Pickup interval: %1 ms").arg(speed_slider->value())
@@ -351,6 +459,37 @@ void main_window::setup_ui() {
     }
 }
 
+void main_window::populate_table() {
+    if (table_widget != nullptr && table_slots_count != nullptr) {
+        table_widget->set_slot_count(table_slots_count->value());
+        table_widget->show();
+        table_widget->schedule_card_preload();
+    }
+}
+
+void main_window::prepare_initial_cards(std::function<void()> ready) {
+    if (table_widget == nullptr) {
+        ready();
+        return;
+    }
+    table_widget->prepare_cards_for_start();
+    if (!table_widget->is_rasterization_busy()) {
+        ready();
+        return;
+    }
+    auto connection = std::make_shared<QMetaObject::Connection>();
+    *connection = QObject::connect(
+        table_widget, &table::rasterization_busy_changed, this,
+        [connection, ready = std::move(ready)](bool busy) {
+            if (busy) {
+                return;
+            }
+            QObject::disconnect(*connection);
+            ready();
+        }
+    );
+}
+
 void main_window::on_continue_button_clicked() {
     int slot_count = table_slots_count->value();
 
@@ -528,7 +667,18 @@ void main_window::start_quiz_from_ui() {
     if (table_widget != nullptr && allow_skipping != nullptr) {
         table_widget->set_allow_skipping(allow_skipping->isChecked());
     }
-    table_widget->start_quiz(quiz_type_index, wait_answers);
+    if (pending_replay != nullptr) {
+        wait_answers = false;
+        table_widget->start_replay(*pending_replay);
+        pending_replay.reset();
+    } else {
+        table_widget->start_quiz(quiz_type_index, wait_answers);
+    }
+    if (status_label != nullptr) {
+        status_label->setToolTip(
+            str_label("Session seed: %1").arg(table_widget->session_seed())
+        );
+    }
 
     quiz_started = true;
     quiz_paused = wait_answers;
@@ -571,18 +721,28 @@ void main_window::start_quiz_from_ui() {
 void main_window::on_settings_triggered() {
     pause_for_dialog();
 
-    QDialog dialog(this);
-    dialog.setWindowTitle(str_label("Settings"));
+    if (settings_dialog == nullptr) {
+        build_settings_dialog();
+    } else if (appearance_settings != nullptr) {
+        appearance_settings->reset_theme_selection();
+    }
+    settings_dialog->exec();
+}
+
+void main_window::build_settings_dialog() {
+    settings_dialog = new QDialog(this);
+    settings_dialog->setWindowTitle(str_label("Settings"));
 
-    auto dialog_layout = new QVBoxLayout(&dialog);
+    auto dialog_layout = new QVBoxLayout(settings_dialog);
 
-    auto tab_widget = new QTabWidget(&dialog);
-    auto shared_state = new settings_shared_state(&dialog);
-    auto appearance_widget = new settings_template_widget(
+    auto tab_widget = new QTabWidget(settings_dialog);
+    auto shared_state = new settings_shared_state(settings_dialog);
+    appearance_settings = new settings_template_widget(
         settings_tab_kind::appearance, tab_widget, QString(), table_widget,
         shared_state
     );
-    tab_widget->addTab(appearance_widget, str_label("Appearance"));
+    appearance_settings->ensure_ui();
+    tab_widget->addTab(appearance_settings, str_label("Appearance"));
     tab_widget->addTab(
         new settings_template_widget(
             settings_tab_kind::strategies, tab_widget, QString(), nullptr,
@@ -592,7 +752,7 @@ void main_window::on_settings_triggered() {
     );
     dialog_layout->addWidget(tab_widget);
 
-    auto button_box = new QDialogButtonBox(&dialog);
+    auto button_box = new QDialogButtonBox(settings_dialog);
     auto save_button
         = button_box->addButton(str_label("Save"), QDialogButtonBox::ApplyRole);
     auto cancel_button = button_box->addButton(
@@ -602,25 +762,42 @@ void main_window::on_settings_triggered() {
         str_label("Save and close"), QDialogButtonBox::AcceptRole
     );
     QObject::connect(
-        save_button, &QAbstractButton::clicked, appearance_widget,
+        save_button, &QAbstractButton::clicked, appearance_settings,
         &settings_template_widget::apply_theme_settings
     );
     QObject::connect(
-        cancel_button, &QAbstractButton::clicked, appearance_widget,
+        cancel_button, &QAbstractButton::clicked, appearance_settings,
         &settings_template_widget::reset_theme_selection
     );
     QObject::connect(
-        close_button, &QAbstractButton::clicked, &dialog,
-        [&dialog, appearance_widget]() {
-            if (appearance_widget != nullptr) {
-                appearance_widget->apply_theme_settings();
+        close_button, &QAbstractButton::clicked, settings_dialog, [this]() {
+            if (appearance_settings != nullptr) {
+                appearance_settings->apply_theme_settings();
             }
-            dialog.accept();
+            settings_dialog->accept();
         }
     );
     dialog_layout->addWidget(button_box);
+    QObject::connect(settings_dialog, &QDialog::finished, this, [this]() {
+        if (settings_dialog_stale) {
+            discard_settings_dialog();
+        }
+    });
+}
 
-    dialog.exec();
+void main_window::discard_settings_dialog() {
+    if (settings_dialog == nullptr) {
+        return;
+    }
+    if (settings_dialog->isVisible()) {
+        // Rebuilt once it closes, so the open tabs are not torn down.
+        settings_dialog_stale = true;
+        return;
+    }
+    settings_dialog->deleteLater();
+    settings_dialog = nullptr;
+    appearance_settings = nullptr;
+    settings_dialog_stale = false;
 }
 
 void main_window::update_status_text() {
@@ -730,11 +907,27 @@ void main_window::reset_game_state(bool show_setup_dialog, bool mark_finished) {
     }
 }
 
+void main_window::show_memory_report() {
+    const QString report
+        = QString::fromStdString(memory_report_text()).toHtmlEscaped();
+    QMessageBox message_box(
+        QMessageBox::Information, str_label("Memory report"),
+        QStringLiteral("<pre>%1</pre>").arg(report), QMessageBox::Ok, this
+    );
+    message_box.setTextFormat(Qt::RichText);
+    message_box.exec();
+}
+
 void main_window::show_game_over_dialog() {
     const QString score_text
         = str_label("Score: %1/%2").arg(score_correct).arg(score_total);
-    QMessageBox::information(
-        this, str_label("Game over"), str_label("Game over\n%1").arg(score_text)
+    QMessageBox message_box(
+        QMessageBox::Information, str_label("Game over"),
+        str_label("Game over\n%1").arg(score_text), QMessageBox::Ok, this
     );
+    if (table_widget != nullptr) {
+        message_box.setDetailedText(table_widget->strategy_comparison_report());
+    }
+    message_box.exec();
     reset_game_state(true, true);
 }
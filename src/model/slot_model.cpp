@@ -0,0 +1,191 @@
+#include "model/slot_model.hpp"
+
+#include <algorithm>
+#include <utility>
+
+slot_model::slot_model()
+    : shoe()
+    , counter()
+    , strategy_weights()
+    , current_score()
+    , deck_cards(0)
+    , decks(0)
+    , checkpoint_interval(default_checkpoint_interval)
+    , infinity_enabled(false)
+    , training_enabled(false)
+    , paused(true)
+    , prompt_active(false) { }
+
+slot_model::slot_model(std::shared_ptr<shoe_bank> bank)
+    : slot_model() {
+    attach(std::move(bank));
+}
+
+int slot_model::cards_for_quiz_type(int quiz_type_index) {
+    if (quiz_type_index == 1) {
+        return 54;
+    }
+    return 52;
+}
+
+void slot_model::attach(std::shared_ptr<shoe_bank> bank) {
+    shoe.attach(std::move(bank));
+}
+
+void slot_model::reseed(const random_generator& generator) {
+    shoe.reseed(generator);
+}
+
+void slot_model::start(
+    int cards_per_deck, int decks_count, bool infinity_enabled
+) {
+    decks_count = std::max(1, decks_count);
+    shoe.setup(cards_per_deck, decks_count, infinity_enabled);
+    counter.reset();
+    counter.add_card(shoe.current_card_index());
+    deck_cards = cards_per_deck;
+    decks = decks_count;
+    this->infinity_enabled = infinity_enabled;
+    prompt_active = false;
+}
+
+void slot_model::clear() {
+    shoe.setup(0, 0, false);
+    counter.reset();
+    deck_cards = 0;
+    decks = 0;
+    infinity_enabled = false;
+    paused = true;
+    prompt_active = false;
+}
+
+void slot_model::set_infinity(bool enabled) {
+    shoe.set_infinity(enabled);
+    infinity_enabled = enabled;
+}
+
+void slot_model::set_training(bool enabled) { training_enabled = enabled; }
+
+void slot_model::set_paused(bool paused) { this->paused = paused; }
+
+void slot_model::set_weights(const QVector<int>& weights) {
+    strategy_weights = weights;
+    counter.set_weights(strategy_weights);
+}
+
+void slot_model::set_checkpoint_interval(int cards) {
+    checkpoint_interval = std::max(0, cards);
+}
+
+bool slot_model::deal() {
+    if (!can_deal()) {
+        return false;
+    }
+
+    shoe.advance();
+    const int position = shoe.current_position();
+    if (position == 0) {
+        counter.reset();
+    }
+    counter.add_card(shoe.current_card_index());
+    if (checkpoint_interval > 0 && position >= 0
+        && (position + 1) % checkpoint_interval == 0) {
+        open_prompt();
+    }
+    return true;
+}
+
+slot_model::answer_outcome slot_model::submit_answer(int provided) {
+    if (!prompt_active) {
+        return answer_outcome::ignored;
+    }
+    if (provided == running_count()) {
+        if (!training_enabled) {
+            ++current_score.correct;
+        }
+        prompt_active = false;
+        return answer_outcome::correct;
+    }
+    if (training_enabled) {
+        return answer_outcome::wrong;
+    }
+    mark_exhausted();
+    return answer_outcome::exhausted;
+}
+
+slot_model::answer_outcome slot_model::skip_question() {
+    if (!prompt_active) {
+        return answer_outcome::ignored;
+    }
+    if (!training_enabled) {
+        --current_score.total;
+    }
+    return answer_outcome::skipped;
+}
+
+bool slot_model::continue_quiz() {
+    if (!prompt_active) {
+        return false;
+    }
+    prompt_active = false;
+    return true;
+}
+
+void slot_model::mark_exhausted() {
+    shoe.set_infinity(false);
+    infinity_enabled = false;
+    shoe.mark_depleted();
+}
+
+bool slot_model::can_deal() const { return !paused && !prompt_active; }
+
+bool slot_model::is_paused() const { return paused; }
+
+bool slot_model::is_prompt_active() const { return prompt_active; }
+
+bool slot_model::is_exhausted() const { return shoe.is_depleted(); }
+
+bool slot_model::is_pickable() const {
+    return !prompt_active && !shoe.is_depleted();
+}
+
+bool slot_model::is_training() const { return training_enabled; }
+
+bool slot_model::is_infinity() const { return infinity_enabled; }
+
+bool slot_model::has_cards() const { return shoe.has_cards(); }
+
+int slot_model::cards_per_deck() const { return deck_cards; }
+
+int slot_model::decks_count() const { return decks; }
+
+int slot_model::current_card_index() const {
+    return shoe.current_card_index();
+}
+
+int slot_model::current_position() const { return shoe.current_position(); }
+
+int slot_model::running_count() const {
+    if (shoe.current_position() < 0) {
+        return 0;
+    }
+    return counter.running_count();
+}
+
+const QVector<int>& slot_model::weights() const { return strategy_weights; }
+
+const std::array<int, rank_counter::ranks_count>&
+slot_model::seen_rank_counts() const {
+    return counter.seen_counts();
+}
+
+const card_picker& slot_model::picker() const { return shoe; }
+
+const slot_score& slot_model::score() const { return current_score; }
+
+void slot_model::open_prompt() {
+    prompt_active = true;
+    if (!training_enabled) {
+        ++current_score.total;
+    }
+}
@@ -0,0 +1,152 @@
+#include "model/table_model.hpp"
+
+#include "card_helpers/shoe_bank.hpp"
+
+#include <algorithm>
+#include <utility>
+
+table_model::table_model()
+    : shoes(std::make_shared<shoe_bank>())
+    , slot_states()
+    , current_mode(dealing_mode::sequential)
+    , selection_gen()
+    , next_slot_index(0)
+    , live_slots()
+    , pickable_slots()
+    , selected() { }
+
+void table_model::set_slot_count(int count) {
+    count = std::max(0, count);
+    const auto new_size = static_cast<std::size_t>(count);
+    if (new_size < slot_states.size()) {
+        slot_states.resize(new_size);
+    }
+    while (slot_states.size() < new_size) {
+        slot_states.push_back(std::make_shared<slot_model>(shoes));
+    }
+    if (next_slot_index >= count) {
+        next_slot_index = 0;
+    }
+    selected.reserve(new_size);
+    refresh_slots();
+}
+
+int table_model::slot_count() const {
+    return static_cast<int>(slot_states.size());
+}
+
+slot_model& table_model::slot(int index) {
+    return *slot_states[static_cast<std::size_t>(index)];
+}
+
+const slot_model& table_model::slot(int index) const {
+    return *slot_states[static_cast<std::size_t>(index)];
+}
+
+const std::shared_ptr<slot_model>& table_model::slot_handle(int index) const {
+    return slot_states[static_cast<std::size_t>(index)];
+}
+
+void table_model::swap_slots(int first, int second) {
+    if (first < 0 || second < 0 || first >= slot_count()
+        || second >= slot_count()) {
+        return;
+    }
+    std::swap(
+        slot_states[static_cast<std::size_t>(first)],
+        slot_states[static_cast<std::size_t>(second)]
+    );
+    refresh_slot(first);
+    refresh_slot(second);
+}
+
+void table_model::set_dealing_mode(dealing_mode mode) { current_mode = mode; }
+
+table_model::dealing_mode table_model::mode() const { return current_mode; }
+
+void table_model::start(std::uint64_t seed) {
+    selection_gen.reseed(seed, 0);
+    next_slot_index = 0;
+    refresh_slots();
+}
+
+void table_model::start_slots(
+    std::uint64_t seed, int cards_per_deck, int decks_count,
+    bool infinity_enabled
+) {
+    std::uint64_t stream = 0;
+    for (const std::shared_ptr<slot_model>& slot_state : slot_states) {
+        ++stream;
+        slot_state->reseed(random_generator(seed, stream).split(0));
+        slot_state->start(cards_per_deck, decks_count, infinity_enabled);
+        slot_state->set_paused(false);
+    }
+    start(seed);
+}
+
+void table_model::refresh_slot(int index) {
+    if (index < 0 || index >= slot_count()) {
+        return;
+    }
+    const slot_model& slot_state = slot(index);
+    live_slots.assign(index, !slot_state.is_exhausted());
+    pickable_slots.assign(index, slot_state.is_pickable());
+}
+
+void table_model::refresh_slots() {
+    live_slots.resize(slot_count());
+    pickable_slots.resize(slot_count());
+    for (int index = 0; index < slot_count(); ++index) {
+        refresh_slot(index);
+    }
+}
+
+const std::vector<int>& table_model::select_next() {
+    selected.clear();
+    if (pickable_slots.empty()) {
+        return selected;
+    }
+
+    switch (current_mode) {
+    case dealing_mode::simultaneous:
+        for (int index = 0; index < slot_count(); ++index) {
+            if (pickable_slots.contains(index)) {
+                selected.push_back(index);
+            }
+        }
+        break;
+    case dealing_mode::random:
+        selected.push_back(pickable_slots.at(
+            selection_gen.uniform_int(0, pickable_slots.size() - 1)
+        ));
+        break;
+    case dealing_mode::sequential: {
+        const int index = pickable_slots.next_from(next_slot_index);
+        next_slot_index = (index + 1) % slot_count();
+        selected.push_back(index);
+        break;
+    }
+    }
+    return selected;
+}
+
+const std::vector<int>& table_model::deal_next() {
+    for (int index : select_next()) {
+        slot(index).deal();
+        refresh_slot(index);
+    }
+    return selected;
+}
+
+bool table_model::is_game_over() const {
+    return !slot_states.empty() && live_slots.empty();
+}
+
+slot_score table_model::total_score() const {
+    slot_score total;
+    for (const std::shared_ptr<slot_model>& slot_state : slot_states) {
+        total.correct += slot_state->score().correct;
+        total.total += slot_state->score().total;
+    }
+    return total;
+}
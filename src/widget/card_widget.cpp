@@ -3,6 +3,7 @@
 #include "card_helpers/card_sheet.hpp"
 #include "helpers/str_label.hpp"
 #include "helpers/theme_settings.hpp"
+#include "helpers/trace_recorder.hpp"
 #include <QColor>
 #include <QFutureWatcher>
 #include <QImage>
@@ -17,16 +18,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace {
 
-int total_cards_for_quiz_type(int quiz_type_index) {
-    if (quiz_type_index == 1) {
-        return 54;
-    }
-    return 52;
-}
-
 qreal compute_font_point_size(const QRectF& card_rect) {
     qreal point_size = card_rect.height() * 0.10;
     return std::clamp(point_size, 8.0, 20.0);
@@ -39,13 +34,6 @@ QString weight_text_for_value(int weight) {
     return QString::number(weight);
 }
 
-int rank_index_from_card_index(int card_index) {
-    if (card_index < 0 || card_index >= 52) {
-        return -1;
-    }
-    return card_index % 13;
-}
-
 QColor blend_color(const QColor& from, const QColor& to, qreal strength) {
     const qreal clamped = std::clamp(strength, 0.0, 1.0);
     const auto lerp = [clamped](int a, int b) {
@@ -59,6 +47,36 @@ QColor blend_color(const QColor& from, const QColor& to, qreal strength) {
     return blended;
 }
 
+qint64 pixmap_bytes(const QVector<QPixmap>& pixmaps) {
+    qint64 total = 0;
+    for (const QPixmap& pixmap : pixmaps) {
+        if (!pixmap.isNull()) {
+            total += static_cast<qint64>(pixmap.width()) * pixmap.height()
+                * pixmap.depth() / 8;
+        }
+    }
+    return total;
+}
+
+/// Moves one raster job from pending to active for the scope of its run.
+class raster_job_scope {
+public:
+    raster_job_scope() {
+        trace_recorder& recorder = trace_recorder::instance();
+        recorder.add_to_counter(trace_counter::raster_jobs_pending, -1);
+        recorder.add_to_counter(trace_counter::raster_jobs_active, 1);
+    }
+
+    ~raster_job_scope() {
+        trace_recorder::instance().add_to_counter(
+            trace_counter::raster_jobs_active, -1
+        );
+    }
+
+    raster_job_scope(const raster_job_scope&) = delete;
+    raster_job_scope& operator=(const raster_job_scope&) = delete;
+};
+
 }
 
 void card_rasterize_watcher::waitForFinished() {
@@ -70,22 +88,15 @@ void card_rasterize_watcher::waitForFinished() {
 
 card_widget::card_widget(BaseWidget* parent)
     : BaseWidget(parent)
-    , running(false)
+    , model_internal(std::make_shared<slot_model>())
     , swap_selected_flag(false)
-    , picker()
     , random_gen()
     , card_rotation_deg(0.0)
     , card_offset(0.0, 0.0)
     , slot_rotated(false)
     , show_card_indexing_flag(false)
     , show_strategy_name_flag(false)
-    , training_mode_flag(false)
     , strategy_name()
-    , strategy_weights()
-    , cards_per_deck(0)
-    , decks_count(0)
-    , infinity_enabled(false)
-    , selection_timer(std::make_unique<time_interface>())
     , selection_phase(0.0)
     , discard_history()
     , highlight_duration_ms(0)
@@ -103,18 +114,18 @@ card_widget::card_widget(BaseWidget* parent)
     , rasterize_watcher()
     , raster_task_size()
     , pending_raster_size()
-    , rasterizing(false) {
-    selection_timer->set_interval(45);
-    QObject::connect(
-        selection_timer.get(), &time_interface::timeout, this,
-        &card_widget::update_selection_pulse
-    );
+    , rasterizing(false)
+    , raster_memory(trace_counter::card_raster_bytes)
+    , face_memory(trace_counter::scaled_face_bytes)
+    , slot_memory(trace_counter::slot_widget_bytes) {
+    model_internal->set_checkpoint_interval(0);
     QObject::connect(
         &rasterize_watcher, &QFutureWatcher<QVector<QImage>>::finished, this,
         &card_widget::on_rasterization_finished
     );
 
     card_sheet_renderer.load(card_sheet_source);
+    report_memory();
 }
 
 card_widget::~card_widget() = default;
@@ -126,11 +137,8 @@ void card_widget::set_swap_selected(bool selected) {
 
     swap_selected_flag = selected;
     if (swap_selected_flag) {
-        if (!selection_timer->is_active()) {
-            selection_timer->start();
-        }
+        emit animation_started();
     } else {
-        selection_timer->stop();
         selection_phase = 0.0;
     }
     update();
@@ -141,33 +149,52 @@ bool card_widget::swap_selected() const { return swap_selected_flag; }
 void card_widget::start_quiz(
     int quiz_type_index, int decks_count, bool infinity_enabled
 ) {
-    const int total_per_deck = total_cards_for_quiz_type(quiz_type_index);
-    if (decks_count <= 0) {
-        decks_count = 1;
-    }
-
-    picker.setup(total_per_deck, decks_count, infinity_enabled);
-    cards_per_deck = total_per_deck;
-    this->decks_count = decks_count;
-    this->infinity_enabled = infinity_enabled;
+    model_internal->start(
+        slot_model::cards_for_quiz_type(quiz_type_index), decks_count,
+        infinity_enabled
+    );
     discard_history.clear();
     picks_since_rasterize = 0;
     update_card_jitter();
+    report_memory();
     update();
 }
 
 void card_widget::set_infinity(bool enabled) {
-    picker.set_infinity(enabled);
-    infinity_enabled = enabled;
+    model_internal->set_infinity(enabled);
     update();
 }
 
+void card_widget::reseed_random(std::uint64_t seed, std::uint64_t stream) {
+    const random_generator slot_generator(seed, stream);
+    model_internal->reseed(slot_generator.split(0));
+    random_gen = slot_generator.split(1);
+}
+
+void card_widget::set_shoe_bank(std::shared_ptr<shoe_bank> bank) {
+    model_internal->attach(std::move(bank));
+}
+
+void card_widget::set_model(std::shared_ptr<slot_model> model) {
+    if (model == nullptr) {
+        return;
+    }
+
+    model_internal = std::move(model);
+    report_memory();
+    update();
+}
+
+slot_model& card_widget::model() { return *model_internal; }
+
+const slot_model& card_widget::model() const { return *model_internal; }
+
 void card_widget::set_running(bool new_running) {
-    if (running == new_running) {
+    if (model_internal->is_paused() != new_running) {
         return;
     }
 
-    running = new_running;
+    model_internal->set_paused(!new_running);
     update();
 }
 
@@ -199,11 +226,11 @@ void card_widget::set_show_strategy_name(bool enabled) {
 }
 
 void card_widget::set_training_mode(bool enabled) {
-    if (training_mode_flag == enabled) {
+    if (model_internal->is_training() == enabled) {
         return;
     }
 
-    training_mode_flag = enabled;
+    model_internal->set_training(enabled);
     update();
 }
 
@@ -217,11 +244,11 @@ void card_widget::set_strategy_name(const QString& name) {
 }
 
 void card_widget::set_strategy_weights(const QVector<int>& weights) {
-    if (strategy_weights == weights) {
+    if (model_internal->weights() == weights) {
         return;
     }
 
-    strategy_weights = weights;
+    model_internal->set_weights(weights);
     update();
 }
 
@@ -240,55 +267,68 @@ void card_widget::set_hide_cards(bool hide) {
 }
 
 void card_widget::advance_card() {
-    if (!running) {
+    if (!model_internal->can_deal()) {
         return;
     }
 
     record_discard();
-    picker.advance();
+    model_internal->deal();
     ++picks_since_rasterize;
     update_card_jitter();
     update();
 }
 
-bool card_widget::has_cards() const { return picker.has_cards(); }
+bool card_widget::has_cards() const { return model_internal->has_cards(); }
 
 bool card_widget::has_current_card() const {
-    return picker.current_card_index() >= 0;
+    return model_internal->current_card_index() >= 0;
 }
 
-bool card_widget::is_deck_exhausted() const { return picker.is_depleted(); }
+bool card_widget::is_deck_exhausted() const {
+    return model_internal->is_exhausted();
+}
 
 void card_widget::mark_deck_exhausted() {
-    picker.set_infinity(false);
-    infinity_enabled = false;
-    picker.mark_depleted();
+    model_internal->mark_exhausted();
     update();
 }
 
-int card_widget::current_position() const { return picker.current_position(); }
+int card_widget::current_position() const {
+    return model_internal->current_position();
+}
+
+int card_widget::current_card_index() const {
+    return model_internal->current_card_index();
+}
 
 int card_widget::current_total_weight() const {
-    return total_weight_for_picks();
+    return model_internal->running_count();
+}
+
+int card_widget::cards_in_deck() const {
+    return model_internal->cards_per_deck();
+}
+
+const QVector<int>& card_widget::strategy_weight_values() const {
+    return model_internal->weights();
+}
+
+const std::array<int, rank_counter::ranks_count>&
+card_widget::seen_rank_counts() const {
+    return model_internal->seen_rank_counts();
 }
 
 void card_widget::clear_quiz() {
-    picker.setup(0, 0, false);
-    cards_per_deck = 0;
-    decks_count = 0;
-    infinity_enabled = false;
+    model_internal->clear();
     discard_history.clear();
     picks_since_rasterize = 0;
-    running = false;
     swap_selected_flag = false;
     highlight_duration_ms = 0;
     highlight_remaining_ms = 0;
     highlight_active = false;
-    if (selection_timer) {
-        selection_timer->stop();
-    }
     selection_phase = 0.0;
     update_card_jitter();
+    report_memory();
     update();
 }
 
@@ -300,23 +340,24 @@ void card_widget::trigger_highlight(int duration_ms) {
     highlight_remaining_ms = duration_ms;
     highlight_active = true;
     update();
+    emit animation_started();
 }
 
-void card_widget::tick_highlight(int delta_ms) {
-    if (!highlight_active) {
-        return;
-    }
-    if (highlight_duration_ms <= 0) {
-        highlight_active = false;
+bool card_widget::advance_animations(int delta_ms, bool highlights_running) {
+    advance_selection_pulse(delta_ms);
+    if (highlight_active && highlights_running) {
+        highlight_remaining_ms -= delta_ms;
+        if (highlight_duration_ms <= 0 || highlight_remaining_ms <= 0) {
+            highlight_active = false;
+            highlight_remaining_ms = 0;
+        }
         update();
-        return;
-    }
-    highlight_remaining_ms -= delta_ms;
-    if (highlight_remaining_ms <= 0) {
-        highlight_active = false;
-        highlight_remaining_ms = 0;
     }
-    update();
+    return is_animating(highlights_running);
+}
+
+bool card_widget::is_animating(bool highlights_running) const {
+    return swap_selected_flag || (highlight_active && highlights_running);
 }
 
 void card_widget::prepare_card_faces() {
@@ -328,6 +369,7 @@ void card_widget::prepare_card_faces() {
 }
 
 void card_widget::paintEvent(QPaintEvent* event) {
+    const trace_zone zone("card_widget::paintEvent", "paint");
     BaseWidget::paintEvent(event);
 
     QPainter painter(this);
@@ -350,10 +392,11 @@ void card_widget::paintEvent(QPaintEvent* event) {
     const QRectF slot_frame_rect
         = base_slot_frame_rect.translated(selection_offset);
 
-    const bool has_deck = picker.has_cards();
-    const int card_index = picker.current_card_index();
+    const bool has_deck = model_internal->has_cards();
+    const int card_index = model_internal->current_card_index();
     const bool has_current_card = card_index >= 0;
-    const bool show_back = has_deck && (!running || !has_current_card);
+    const bool show_back
+        = has_deck && (model_internal->is_paused() || !has_current_card);
     const qreal inset = std::clamp(min_dim * 0.08, 4.0, 12.0);
     const QRectF card_rect
         = slot_frame_rect.adjusted(inset, inset, -inset, -inset);
@@ -422,14 +465,18 @@ void card_widget::paintEvent(QPaintEvent* event) {
         if (!show_card_indexing_flag) {
             return;
         }
-        const int position = picker.current_position();
+        const int position = model_internal->current_position();
         QString index_text;
         if (position >= 0) {
             const int current_value = position + 1;
-            if (infinity_enabled) {
+            if (model_internal->is_infinity()) {
                 index_text = QString::number(current_value);
             } else {
-                const int total = std::max(1, cards_per_deck * decks_count);
+                const int total = std::max(
+                    1,
+                    model_internal->cards_per_deck()
+                        * model_internal->decks_count()
+                );
                 index_text = str_label("%1/%2").arg(current_value).arg(total);
             }
         }
@@ -638,9 +685,9 @@ void card_widget::paintEvent(QPaintEvent* event) {
     if (show_strategy_name_flag && !strategy_name.isEmpty()) {
         extra_lines.append(strategy_name);
     }
-    if (training_mode_flag) {
-        if (picker.current_card_index() >= 0) {
-            const int total_weight = total_weight_for_picks();
+    if (model_internal->is_training()) {
+        if (model_internal->current_card_index() >= 0) {
+            const int total_weight = model_internal->running_count();
             extra_lines.append(weight_text_for_value(total_weight));
         }
     }
@@ -766,6 +813,7 @@ void card_widget::update_card_faces(const QSize& target_size) {
         card_face_raster_size = QSize();
         picks_since_rasterize = 0;
         pending_raster_size = QSize();
+        report_memory();
         return;
     }
 
@@ -780,6 +828,7 @@ void card_widget::update_card_faces(const QSize& target_size) {
         card_face_raster_size = QSize();
         picks_since_rasterize = 0;
         pending_raster_size = QSize();
+        report_memory();
         return;
     }
 
@@ -818,12 +867,14 @@ void card_widget::update_card_faces(const QSize& target_size) {
         }
     }
     card_face_size = target_size;
+    report_memory();
 }
 
 void card_widget::start_rasterization(const QSize& target_size) {
     if (target_size.isEmpty()) {
         return;
     }
+    const trace_zone zone("card_widget::start_rasterization", "raster");
 
     raster_task_size = target_size;
     pending_raster_size = QSize();
@@ -837,8 +888,13 @@ void card_widget::start_rasterization(const QSize& target_size) {
     }
     const QSize raster_size = target_size;
 
+    trace_recorder::instance().add_to_counter(
+        trace_counter::raster_jobs_pending, 1
+    );
     rasterize_watcher.setFuture(
         QtConcurrent::run([source, element_ids, raster_size]() {
+            const raster_job_scope job;
+            const trace_zone zone("card_widget::raster_job", "raster");
             QVector<QImage> images;
             images.reserve(element_ids.size());
 
@@ -902,6 +958,7 @@ void card_widget::apply_rasterized_images(
         }
     }
     picks_since_rasterize = 0;
+    report_memory();
 }
 
 void card_widget::set_rasterizing(bool active) {
@@ -930,11 +987,11 @@ void card_widget::on_rasterization_finished() {
 }
 
 void card_widget::record_discard() {
-    if (!picker.has_cards()) {
+    if (!model_internal->has_cards()) {
         return;
     }
 
-    const int card_index = picker.current_card_index();
+    const int card_index = model_internal->current_card_index();
     if (card_index < 0) {
         return;
     }
@@ -945,27 +1002,6 @@ void card_widget::record_discard() {
     }
 }
 
-int card_widget::total_weight_for_picks() const {
-    if (strategy_weights.isEmpty()) {
-        return 0;
-    }
-
-    const int current_position = picker.current_position();
-    if (current_position < 0) {
-        return 0;
-    }
-
-    int total_weight = 0;
-    for (int position = 0; position <= current_position; ++position) {
-        const int card_index = picker.card_index_at(position);
-        const int rank_index = rank_index_from_card_index(card_index);
-        if (rank_index >= 0 && rank_index < strategy_weights.size()) {
-            total_weight += strategy_weights.at(rank_index);
-        }
-    }
-    return total_weight;
-}
-
 qreal card_widget::highlight_strength() const {
     if (!highlight_active || highlight_duration_ms <= 0) {
         return 0.0;
@@ -975,13 +1011,28 @@ qreal card_widget::highlight_strength() const {
     return std::clamp(remaining_ratio, 0.0, 1.0);
 }
 
-void card_widget::update_selection_pulse() {
+void card_widget::advance_selection_pulse(int delta_ms) {
     if (!swap_selected_flag) {
         return;
     }
-    selection_phase += 0.35;
-    if (selection_phase > 6.283) {
-        selection_phase -= 6.283;
-    }
+    const qreal phase_per_ms = 0.35 / 45.0;
+    selection_phase
+        = std::fmod(selection_phase + phase_per_ms * delta_ms, 6.283);
     update();
 }
+
+qint64 card_widget::raster_cache_bytes() const {
+    return pixmap_bytes(card_faces_rasterized) + pixmap_bytes(card_faces);
+}
+
+void card_widget::report_memory() {
+    raster_memory.set(pixmap_bytes(card_faces_rasterized));
+    face_memory.set(pixmap_bytes(card_faces));
+    // The widget, its model and the shoe's card and stamp bytes.
+    const qint64 shoe_bytes
+        = 2 * static_cast<qint64>(model_internal->picker().total_cards());
+    slot_memory.set(
+        static_cast<qint64>(sizeof(card_widget) + sizeof(slot_model))
+        + shoe_bytes
+    );
+}
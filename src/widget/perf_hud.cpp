@@ -0,0 +1,218 @@
+#include "widget/perf_hud.hpp"
+
+#include "helpers/memory_report.hpp"
+#include "helpers/stall_watchdog.hpp"
+#include "helpers/str_label.hpp"
+#include "helpers/trace_recorder.hpp"
+#include "widget/table.hpp"
+
+#include <QColor>
+#include <QEvent>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QHideEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QShowEvent>
+
+#include <algorithm>
+
+namespace {
+constexpr int kPadding = 6;
+constexpr int kMargin = 8;
+} // namespace
+
+perf_hud::perf_hud(table* owner)
+    : BaseWidget(owner)
+    , owner(owner)
+    , sample_timer()
+    , heartbeat_timer()
+    , owns_watchdog(false)
+    , clock()
+    , watched_window()
+    , in_frame(false)
+    , last_sample_ms(0)
+    , frames(0)
+    , worst_frame_us(0)
+    , lines() {
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    sample_timer.set_interval(sample_interval_ms);
+    QObject::connect(
+        &sample_timer, &time_interface::timeout, this, &perf_hud::sample
+    );
+    heartbeat_timer.set_interval(
+        static_cast<int>(stall_watchdog::default_threshold_ms / 2)
+    );
+    QObject::connect(&heartbeat_timer, &time_interface::timeout, this, []() {
+        stall_watchdog::instance().heartbeat();
+    });
+    clock.start();
+    hide();
+}
+
+perf_hud::~perf_hud() {
+    watch_window(nullptr);
+    release_watchdog();
+}
+
+bool perf_hud::eventFilter(QObject* watched, QEvent* event) {
+    if (watched != watched_window || in_frame
+        || event->type() != QEvent::UpdateRequest) {
+        return BaseWidget::eventFilter(watched, event);
+    }
+    // Handle the update request here so the whole repaint and flush can be
+    // timed; filters installed before this one do not see it.
+    in_frame = true;
+    QElapsedTimer frame_timer;
+    frame_timer.start();
+    watched->event(event);
+    worst_frame_us
+        = std::max(worst_frame_us, frame_timer.nsecsElapsed() / 1000);
+    ++frames;
+    in_frame = false;
+    return true;
+}
+
+void perf_hud::paintEvent(QPaintEvent* event) {
+    BaseWidget::paintEvent(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 170));
+    painter.drawRoundedRect(rect(), 4.0, 4.0);
+
+    painter.setPen(Qt::white);
+    const QFontMetrics metrics(font());
+    int baseline = kPadding + metrics.ascent();
+    for (const QString& line : lines) {
+        painter.drawText(kPadding, baseline, line);
+        baseline += metrics.lineSpacing();
+    }
+}
+
+void perf_hud::showEvent(QShowEvent* event) {
+    BaseWidget::showEvent(event);
+    watch_window(owner != nullptr ? owner->window() : nullptr);
+    frames = 0;
+    worst_frame_us = 0;
+    last_sample_ms = clock.elapsed();
+    trace_recorder::instance().take_counter(trace_counter::deal_jitter_us);
+    stall_watchdog& watchdog = stall_watchdog::instance();
+    if (!watchdog.is_running()) {
+        trace_recorder::instance().track_zones();
+        watchdog.start();
+        heartbeat_timer.start();
+        owns_watchdog = true;
+    }
+    sample_timer.start();
+    sample();
+}
+
+void perf_hud::hideEvent(QHideEvent* event) {
+    sample_timer.stop();
+    watch_window(nullptr);
+    release_watchdog();
+    BaseWidget::hideEvent(event);
+}
+
+void perf_hud::sample() {
+    if (owner == nullptr) {
+        return;
+    }
+    trace_recorder& recorder = trace_recorder::instance();
+    const qint64 now_ms = clock.elapsed();
+    const qint64 elapsed_ms = std::max<qint64>(1, now_ms - last_sample_ms);
+    last_sample_ms = now_ms;
+
+    const double fps = frames * 1000.0 / static_cast<double>(elapsed_ms);
+    const qint64 jitter_us
+        = recorder.take_counter(trace_counter::deal_jitter_us);
+    lines.clear();
+    const double worst_frame_ms = static_cast<double>(worst_frame_us) / 1000.0;
+    lines.append(str_label("FPS %1  worst frame %2 ms")
+                     .arg(fps, 0, 'f', 1)
+                     .arg(worst_frame_ms, 0, 'f', 1));
+    lines.append(
+        str_label("Raster jobs %1 pending, %2 active")
+            .arg(recorder.counter(trace_counter::raster_jobs_pending))
+            .arg(recorder.counter(trace_counter::raster_jobs_active))
+    );
+    const std::vector<memory_usage> memory = memory_usage_by_subsystem();
+    qint64 memory_total = 0;
+    for (const memory_usage& usage : memory) {
+        memory_total += usage.bytes;
+    }
+    lines.append(
+        str_label("Memory %1").arg(locale().formattedDataSize(memory_total))
+    );
+    for (const memory_usage& usage : memory) {
+        lines.append(str_label("  %1 %2 (peak %3)")
+                         .arg(QString::fromLatin1(usage.subsystem))
+                         .arg(locale().formattedDataSize(usage.bytes))
+                         .arg(locale().formattedDataSize(usage.peak_bytes)));
+    }
+    const QVector<qint64> slot_bytes = owner->slot_cache_bytes();
+    for (int slot = 0; slot < slot_bytes.size(); ++slot) {
+        lines.append(str_label("  slot %1 cards: %2")
+                         .arg(slot + 1)
+                         .arg(locale().formattedDataSize(slot_bytes.at(slot))));
+    }
+    lines.append(str_label("Deal jitter %1 ms of %2 ms interval")
+                     .arg(static_cast<double>(jitter_us) / 1000.0, 0, 'f', 1)
+                     .arg(owner->pick_interval()));
+    lines.append(
+        str_label("Event-loop stalls %1 (over %2 ms)")
+            .arg(recorder.counter(trace_counter::event_loop_stalls))
+            .arg(stall_watchdog::instance().threshold_ms())
+    );
+    const std::vector<stall_zone_count> stall_zones
+        = stall_watchdog::instance().stalls_by_zone();
+    const std::size_t listed = std::min<std::size_t>(
+        stall_zones.size(), static_cast<std::size_t>(listed_stall_zones)
+    );
+    for (std::size_t index = 0; index < listed; ++index) {
+        const stall_zone_count& zone = stall_zones[index];
+        lines.append(str_label("  %1 x%2, worst %3 ms")
+                         .arg(QString::fromStdString(zone.zone))
+                         .arg(zone.stalls)
+                         .arg(zone.worst_ms));
+    }
+    frames = 0;
+    worst_frame_us = 0;
+
+    const QFontMetrics metrics(font());
+    int width = 0;
+    for (const QString& line : lines) {
+        width = std::max(width, metrics.horizontalAdvance(line));
+    }
+    setFixedSize(
+        width + 2 * kPadding,
+        static_cast<int>(lines.size()) * metrics.lineSpacing() + 2 * kPadding
+    );
+    move(kMargin, kMargin);
+    raise();
+    update();
+}
+
+void perf_hud::release_watchdog() {
+    if (!owns_watchdog) {
+        return;
+    }
+    heartbeat_timer.stop();
+    stall_watchdog::instance().stop();
+    owns_watchdog = false;
+}
+
+void perf_hud::watch_window(QWidget* window) {
+    if (watched_window == window) {
+        return;
+    }
+    if (watched_window != nullptr) {
+        watched_window->removeEventFilter(this);
+    }
+    watched_window = window;
+    if (watched_window != nullptr) {
+        watched_window->installEventFilter(this);
+    }
+}
@@ -5,6 +5,7 @@
 #include "helpers/str_label.hpp"
 #include "helpers/theme_palette.hpp"
 #include "helpers/theme_settings.hpp"
+#include "widget/strategy_details_model.hpp"
 #include "widget/table.hpp"
 
 #include <QAbstractItemView>
@@ -23,12 +24,16 @@
 #include <QPushButton>
 #include <QRadioButton>
 #include <QScrollArea>
+#include <QShowEvent>
 #include <QStyle>
 #include <QSvgRenderer>
-#include <QTableWidget>
+#include <QTableView>
+#include <QtConcurrent>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <memory>
 
 namespace {
 QColor theme_color_from_label(const QString& label) {
@@ -98,9 +103,22 @@ QSize preview_card_size() {
     return QSize(width, target_long);
 }
 
-QPixmap
+// Previews render on pool threads; each keeps its own parsed sheet so the
+// SVG is read once per thread instead of once per card.
+QSvgRenderer& preview_renderer() {
+    thread_local QString loaded_source;
+    thread_local std::unique_ptr<QSvgRenderer> renderer;
+    const QString source = card_sheet_source_path();
+    if (renderer == nullptr || loaded_source != source) {
+        renderer = std::make_unique<QSvgRenderer>(source);
+        loaded_source = source;
+    }
+    return *renderer;
+}
+
+QImage
 build_card_preview(int rank_index, int suit_index, const QSize& card_size) {
-    QSvgRenderer renderer(card_sheet_source_path());
+    QSvgRenderer& renderer = preview_renderer();
     if (!renderer.isValid() || !card_size.isValid()) {
         return {};
     }
@@ -121,7 +139,7 @@ build_card_preview(int rank_index, int suit_index, const QSize& card_size) {
         &painter, element_id, QRectF(QPointF(0.0, 0.0), QSizeF(card_size))
     );
     painter.end();
-    return QPixmap::fromImage(image);
+    return image;
 }
 
 QString weight_text_for_value(int weight) {
@@ -139,11 +157,11 @@ QString format_key_label(QString key) {
     return key;
 }
 
-QPixmap build_weighted_card_preview(
+QImage build_weighted_card_preview(
     int rank_index, int suit_index, const QSize& card_size,
     const QVector<int>& weights
 ) {
-    QSvgRenderer renderer(card_sheet_source_path());
+    QSvgRenderer& renderer = preview_renderer();
     if (!renderer.isValid() || !card_size.isValid()) {
         return {};
     }
@@ -192,11 +210,24 @@ QPixmap build_weighted_card_preview(
     );
     painter.end();
 
-    return QPixmap::fromImage(image);
+    return image;
+}
+
+QString weighted_preview_tag(int suit_index, const QVector<int>& weights) {
+    QStringList parts;
+    parts.reserve(weights.size());
+    for (const int weight : weights) {
+        parts.append(QString::number(weight));
+    }
+    return QStringLiteral("weights/%1/%2")
+        .arg(suit_index)
+        .arg(parts.join(QLatin1Char(',')));
 }
 
-QTableWidget* build_readonly_table(int rows, int columns, QWidget* parent) {
-    auto table = new QTableWidget(rows, columns, parent);
+QTableView*
+build_readonly_table(strategy_details_model* model, QWidget* parent) {
+    auto table = new QTableView(parent);
+    table->setModel(model);
     table->setEditTriggers(QAbstractItemView::NoEditTriggers);
     table->setSelectionMode(QAbstractItemView::NoSelection);
     table->setFocusPolicy(Qt::NoFocus);
@@ -227,6 +258,98 @@ QString build_bullet_list(const QStringList& entries) {
     }
     return lines.join(str_label("<br>"));
 }
+
+const QStringList& general_field_keys() {
+    static const QStringList keys
+        = { str_label("date"),    str_label("author"),
+            str_label("games"),   str_label("min_decks"),
+            str_label("balance"), str_label("ace_neutral") };
+    return keys;
+}
+
+const QStringList& metric_field_keys() {
+    static const QStringList keys
+        = { str_label("betting_correlation"), str_label("playing_efficiency"),
+            str_label("insurance_correlation"), str_label("ease_of_use") };
+    return keys;
+}
+
+QStringList format_key_labels(const QStringList& keys) {
+    QStringList labels;
+    labels.reserve(keys.size());
+    for (const QString& key : keys) {
+        labels.append(format_key_label(key));
+    }
+    return labels;
+}
+
+strategy_details_text build_details_text(
+    const strategy_data& strategy, const strategy_metrics* simulated
+) {
+    strategy_details_text text;
+
+    QStringList note_entries;
+    for (auto it = strategy.unique_fields.constBegin();
+         it != strategy.unique_fields.constEnd(); ++it) {
+        QString entry_label = format_key_label(it.key());
+        QString entry = it.value();
+        if (!entry_label.isEmpty()) {
+            entry = str_label("%1: %2").arg(entry_label, it.value());
+        }
+        note_entries.append(entry);
+    }
+    if (!note_entries.isEmpty()) {
+        text.notes_html = build_bullet_list(note_entries);
+    }
+
+    QStringList reference_entries;
+    for (const auto& ref : strategy.references) {
+        QString entry = ref.citation;
+        if (!ref.url.isEmpty()) {
+            entry += str_label(" <a href=\"%1\">%1</a>").arg(ref.url);
+        }
+        if (!ref.accessed.isEmpty()) {
+            entry += str_label(" (accessed %1)").arg(ref.accessed);
+        }
+        reference_entries.append(entry);
+    }
+    if (!reference_entries.isEmpty()) {
+        text.references_html = build_ieee_list(reference_entries);
+    }
+
+    const QString min_decks_value = strategy.min_decks > 0
+        ? QString::number(strategy.min_decks)
+        : str_label("-");
+    text.general_values
+        = { strategy.date,
+            strategy.authors.join(", "),
+            strategy.games.join(", "),
+            min_decks_value,
+            strategy.balance ? str_label("true") : str_label("false"),
+            strategy.ace_neutral ? str_label("true") : str_label("false") };
+
+    const QStringList& metric_keys = metric_field_keys();
+    text.metric_values.reserve(metric_keys.size());
+    for (int row = 0; row < metric_keys.size(); ++row) {
+        const QString& key = metric_keys.at(row);
+        QString value = strategy.metrics.contains(key)
+            ? QString::number(strategy.metrics.value(key))
+            : str_label("-");
+        const auto estimate = static_cast<std::size_t>(row);
+        if (simulated != nullptr && estimate < 3) {
+            const std::array<double, 3> estimates {
+                simulated->betting_correlation,
+                simulated->playing_efficiency,
+                simulated->insurance_correlation,
+            };
+            value = str_label("%1 (simulated %2)")
+                        .arg(value)
+                        .arg(estimates[estimate], 0, 'f', 3);
+        }
+        text.metric_values.append(value);
+    }
+    return text;
+}
 } // namespace
 
 settings_shared_state::settings_shared_state(QObject* parent)
@@ -265,6 +388,8 @@ settings_template_widget::settings_template_widget(
 )
     : BaseWidget(parent)
     , tab_kind(tab_kind)
+    , ui_built(false)
+    , initial_strategy(selected_strategy)
     , table_widget(table_widget)
     , shared_state(
           shared_state != nullptr ? shared_state
@@ -279,18 +404,43 @@ settings_template_widget::settings_template_widget(
     , references_title_label(nullptr)
     , references_label(nullptr)
     , weights_carousel(nullptr)
+    , general_model(nullptr)
+    , metrics_model(nullptr)
     , general_table(nullptr)
     , metrics_table(nullptr)
+    , details_text()
+    , simulate_button(nullptr)
+    , simulation_watcher()
+    , simulator()
+    , simulation_progress_timer()
+    , simulated_strategy_id(0)
+    , simulated_metrics()
     , suit_combo_box(nullptr)
     , theme_combo_box(nullptr)
     , orientation_combo_box(nullptr)
     , theme_palette_preview(nullptr)
     , theme_button_group(nullptr)
-    , theme_carousel(nullptr) {
-    setup_ui(selected_strategy);
+    , theme_carousel(nullptr) { }
+
+settings_template_widget::~settings_template_widget() {
+    if (simulator != nullptr) {
+        simulator->cancel();
+    }
+    simulation_watcher.waitForFinished();
 }
 
-settings_template_widget::~settings_template_widget() = default;
+void settings_template_widget::ensure_ui() {
+    if (ui_built) {
+        return;
+    }
+    ui_built = true;
+    setup_ui(initial_strategy);
+}
+
+void settings_template_widget::showEvent(QShowEvent* event) {
+    ensure_ui();
+    BaseWidget::showEvent(event);
+}
 
 void settings_template_widget::setup_ui(const QString& selected_strategy) {
     if (tab_kind == settings_tab_kind::appearance) {
@@ -321,9 +471,17 @@ void settings_template_widget::setup_strategy_ui(
 
     strategy_list_widget = new QListWidget(dock_widget);
     strategy_list_widget->setSelectionMode(QAbstractItemView::SingleSelection);
-    strategies = load_strategies();
+    strategies = strategy_registry::instance()->strategies();
+    details_text.clear();
+    details_text.reserve(strategies.size());
     for (const strategy_data& strategy : strategies) {
         strategy_list_widget->addItem(strategy.name);
+        const auto simulated = simulated_metrics.constFind(strategy.id);
+        details_text.append(build_details_text(
+            strategy,
+            simulated != simulated_metrics.constEnd() ? &simulated.value()
+                                                      : nullptr
+        ));
     }
     dock_layout->addWidget(strategy_list_widget, 1);
 
@@ -409,10 +567,10 @@ void settings_template_widget::setup_strategy_ui(
     right_layout->setContentsMargins(0, 0, 0, 0);
     right_layout->setSpacing(8);
 
-    general_table = build_readonly_table(6, 2, right_column);
-    general_table->setHorizontalHeaderLabels(
-        QStringList() << str_label("General") << str_label("Value")
+    general_model = new strategy_details_model(
+        str_label("General"), format_key_labels(general_field_keys()), this
     );
+    general_table = build_readonly_table(general_model, right_column);
     general_table->horizontalHeader()->setSectionResizeMode(
         QHeaderView::ResizeToContents
     );
@@ -421,10 +579,10 @@ void settings_template_widget::setup_strategy_ui(
     );
     right_layout->addWidget(general_table);
 
-    metrics_table = build_readonly_table(4, 2, right_column);
-    metrics_table->setHorizontalHeaderLabels(
-        QStringList() << str_label("Metrics") << str_label("Value")
+    metrics_model = new strategy_details_model(
+        str_label("Metrics"), format_key_labels(metric_field_keys()), this
     );
+    metrics_table = build_readonly_table(metrics_model, right_column);
     metrics_table->horizontalHeader()->setSectionResizeMode(
         QHeaderView::ResizeToContents
     );
@@ -432,6 +590,26 @@ void settings_template_widget::setup_strategy_ui(
         1, QHeaderView::Stretch
     );
     right_layout->addWidget(metrics_table);
+
+    simulate_button = new BasePushButton(right_column);
+    simulate_button->setText(str_label("Simulate metrics"));
+    simulate_button->setToolTip(
+        str_label("Estimate betting correlation, playing efficiency and "
+                  "insurance correlation with a Monte Carlo simulation")
+    );
+    right_layout->addWidget(simulate_button);
+    connect(simulate_button, &BasePushButton::clicked, this, [this]() {
+        start_metrics_simulation();
+    });
+    connect(
+        &simulation_watcher, &QFutureWatcher<strategy_metrics>::finished, this,
+        [this]() { finish_metrics_simulation(); }
+    );
+    simulation_progress_timer.set_interval(100);
+    connect(
+        &simulation_progress_timer, &time_interface::timeout, this,
+        [this]() { update_simulation_progress(); }
+    );
     right_layout->addStretch();
 
     scroll_layout->addWidget(left_column, 2);
@@ -623,84 +801,92 @@ void settings_template_widget::update_strategy_details(int index) {
     }
     update_weights_carousel(shared_state->default_suit());
 
-    QStringList note_entries;
-    for (auto it = strategy.unique_fields.constBegin();
-         it != strategy.unique_fields.constEnd(); ++it) {
-        QString entry_label = format_key_label(it.key());
-        QString entry = it.value();
-        if (!entry_label.isEmpty()) {
-            entry = str_label("%1: %2").arg(entry_label, it.value());
-        }
-        note_entries.append(entry);
+    if (index >= details_text.size()) {
+        return;
     }
-
+    const strategy_details_text& text = details_text[index];
     if (notes_title_label != nullptr && notes_label != nullptr) {
-        const bool has_notes = !note_entries.isEmpty();
+        const bool has_notes = !text.notes_html.isEmpty();
         notes_title_label->setVisible(has_notes);
         notes_label->setVisible(has_notes);
-        notes_label->setText(build_bullet_list(note_entries));
+        notes_label->setText(text.notes_html);
     }
-
     if (references_title_label != nullptr && references_label != nullptr) {
-        QStringList reference_entries;
-        for (const auto& ref : strategy.references) {
-            QString entry = ref.citation;
-            if (!ref.url.isEmpty()) {
-                entry += str_label(" <a href=\"%1\">%1</a>").arg(ref.url);
-            }
-            if (!ref.accessed.isEmpty()) {
-                entry += str_label(" (accessed %1)").arg(ref.accessed);
-            }
-            reference_entries.append(entry);
-        }
-        const bool has_references = !reference_entries.isEmpty();
+        const bool has_references = !text.references_html.isEmpty();
         references_title_label->setVisible(has_references);
         references_label->setVisible(has_references);
-        references_label->setText(build_ieee_list(reference_entries));
+        references_label->setText(text.references_html);
+    }
+    if (general_model != nullptr) {
+        general_model->set_values(text.general_values);
+    }
+    if (metrics_model != nullptr) {
+        metrics_model->set_values(text.metric_values);
     }
+}
 
-    if (general_table != nullptr) {
-        const QString min_decks_value = strategy.min_decks > 0
-            ? QString::number(strategy.min_decks)
-            : str_label("-");
-        const QStringList label_keys
-            = { str_label("date"),    str_label("author"),
-                str_label("games"),   str_label("min_decks"),
-                str_label("balance"), str_label("ace_neutral") };
-        const QStringList values
-            = { strategy.date,
-                strategy.authors.join(", "),
-                strategy.games.join(", "),
-                min_decks_value,
-                strategy.balance ? str_label("true") : str_label("false"),
-                strategy.ace_neutral ? str_label("true") : str_label("false") };
-        for (int row = 0; row < label_keys.size(); ++row) {
-            general_table->setItem(
-                row, 0,
-                new QTableWidgetItem(format_key_label(label_keys.at(row)))
-            );
-            general_table->setItem(
-                row, 1, new QTableWidgetItem(values.at(row))
-            );
-        }
+void settings_template_widget::start_metrics_simulation() {
+    if (simulation_watcher.isRunning() || strategy_list_widget == nullptr) {
+        return;
+    }
+    const int index = strategy_list_widget->currentRow();
+    if (index < 0 || index >= strategies.size()) {
+        return;
     }
 
-    if (metrics_table != nullptr) {
-        const QStringList metric_labels
-            = { str_label("betting_correlation"),
-                str_label("playing_efficiency"),
-                str_label("insurance_correlation"), str_label("ease_of_use") };
-        for (int row = 0; row < metric_labels.size(); ++row) {
-            const QString label = metric_labels.at(row);
-            const QString value = strategy.metrics.contains(label)
-                ? QString::number(strategy.metrics.value(label))
-                : str_label("-");
-            metrics_table->setItem(
-                row, 0, new QTableWidgetItem(format_key_label(label))
-            );
-            metrics_table->setItem(row, 1, new QTableWidgetItem(value));
+    const strategy_data& strategy = strategies.at(index);
+    simulated_strategy_id = strategy.id;
+    simulator = std::make_shared<strategy_simulator>();
+    const std::shared_ptr<strategy_simulator> runner = simulator;
+    const QVector<int> weights = strategy.weights;
+    simulation_watcher.setFuture(QtConcurrent::run([runner, weights]() {
+        return runner->run(weights);
+    }));
+
+    simulate_button->setEnabled(false);
+    update_simulation_progress();
+    simulation_progress_timer.start();
+}
+
+void settings_template_widget::update_simulation_progress() {
+    if (simulator == nullptr || simulate_button == nullptr) {
+        return;
+    }
+    const std::uint64_t total
+        = std::max<std::uint64_t>(1, simulator->total_rounds());
+    const int percent = static_cast<int>(
+        100.0 * static_cast<double>(simulator->completed_rounds())
+        / static_cast<double>(total)
+    );
+    simulate_button->setText(str_label("Simulating... %1%").arg(percent));
+}
+
+void settings_template_widget::finish_metrics_simulation() {
+    simulation_progress_timer.stop();
+    if (simulate_button != nullptr) {
+        simulate_button->setEnabled(true);
+        simulate_button->setText(str_label("Simulate metrics"));
+    }
+    if (simulator == nullptr) {
+        return;
+    }
+
+    const strategy_metrics metrics = simulation_watcher.result();
+    simulator.reset();
+    if (metrics.cancelled) {
+        return;
+    }
+    simulated_metrics.insert(simulated_strategy_id, metrics);
+    for (int index = 0; index < strategies.size(); ++index) {
+        if (strategies[index].id == simulated_strategy_id
+            && index < details_text.size()) {
+            details_text[index]
+                = build_details_text(strategies[index], &metrics);
         }
     }
+    if (strategy_list_widget != nullptr) {
+        update_strategy_details(strategy_list_widget->currentRow());
+    }
 }
 
 void settings_template_widget::update_theme_palette_preview(int index) {
@@ -742,9 +928,11 @@ void settings_template_widget::update_theme_carousel(int suit_index) {
     const QSize card_size = preview_card_size();
     theme_carousel->set_card_size(card_size);
     theme_carousel->set_card_provider(
-        13, [suit_index](int card_index, const QSize& size) {
+        13,
+        [suit_index](int card_index, const QSize& size) {
             return build_card_preview(card_index, suit_index, size);
-        }
+        },
+        QStringLiteral("face/%1").arg(suit_index)
     );
 }
 
@@ -762,11 +950,13 @@ void settings_template_widget::update_weights_carousel(int suit_index) {
     const QSize card_size = preview_card_size();
     weights_carousel->set_card_size(card_size);
     weights_carousel->set_card_provider(
-        13, [weights, suit_index](int card_index, const QSize& size) {
+        13,
+        [weights, suit_index](int card_index, const QSize& size) {
             return build_weighted_card_preview(
                 card_index, suit_index, size, weights
             );
-        }
+        },
+        weighted_preview_tag(suit_index, weights)
     );
 }
 
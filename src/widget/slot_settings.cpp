@@ -7,6 +7,9 @@
 
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QStringList>
+
+#include <algorithm>
 
 slot_settings::slot_settings(BaseWidget* parent, bool include_info_button)
     : BaseWidget(parent)
@@ -35,6 +38,37 @@ QSize slot_settings::minimum_settings_size() {
     return cached_size;
 }
 
+void slot_settings::fill_strategy_names(BaseComboBox* combo_box) {
+    if (combo_box == nullptr) {
+        return;
+    }
+
+    QStringList names;
+    const auto registry = strategy_registry::instance();
+    for (const strategy_data& strategy : registry->strategies()) {
+        names.append(strategy.name);
+    }
+    if (names.isEmpty()) {
+        names.append(str_label("Default strategy"));
+    }
+
+    QStringList current_names;
+    for (int index = 0; index < combo_box->count(); ++index) {
+        current_names.append(combo_box->itemText(index));
+    }
+    if (current_names == names) {
+        return;
+    }
+
+    const QString selected = combo_box->currentText();
+    const bool was_blocked = combo_box->blockSignals(true);
+    combo_box->clear();
+    combo_box->addItems(names);
+    combo_box->setCurrentIndex(
+        std::max(0, static_cast<int>(names.indexOf(selected))));
+    combo_box->blockSignals(was_blocked);
+}
+
 void slot_settings::setup_ui(bool include_info_button) {
     auto settings_layout = new BaseVBoxLayout(this);
     settings_layout->setContentsMargins(8, 8, 8, 4);
@@ -77,14 +111,7 @@ void slot_settings::setup_ui(bool include_info_button) {
     strategy_label->setToolTip(strategy_tooltip);
     strategy_combo_box_internal = new BaseComboBox(this);
     strategy_combo_box_internal->setToolTip(strategy_tooltip);
-    const QVector<strategy_data> strategies = load_strategies();
-    if (strategies.isEmpty()) {
-        strategy_combo_box_internal->addItem(str_label("Default strategy"));
-    } else {
-        for (const strategy_data& strategy : strategies) {
-            strategy_combo_box_internal->addItem(strategy.name);
-        }
-    }
+    fill_strategy_names(strategy_combo_box_internal);
     strategy_layout->addWidget(strategy_label);
     strategy_layout->addWidget(strategy_combo_box_internal, 1);
 
@@ -0,0 +1,52 @@
+#include "widget/strategy_details_model.hpp"
+
+#include "helpers/str_label.hpp"
+
+strategy_details_model::strategy_details_model(
+    const QString& title, const QStringList& labels, QObject* parent
+)
+    : QAbstractTableModel(parent)
+    , title(title)
+    , value_title(str_label("Value"))
+    , labels(labels)
+    , values() { }
+
+void strategy_details_model::set_values(const QStringList& next_values) {
+    values = next_values;
+    if (labels.isEmpty()) {
+        return;
+    }
+    emit dataChanged(
+        index(0, 1), index(static_cast<int>(labels.size()) - 1, 1),
+        { Qt::DisplayRole }
+    );
+}
+
+int strategy_details_model::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(labels.size());
+}
+
+int strategy_details_model::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : 2;
+}
+
+QVariant
+strategy_details_model::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || role != Qt::DisplayRole) {
+        return {};
+    }
+    const int row = index.row();
+    if (index.column() == 0) {
+        return labels.value(row);
+    }
+    return values.value(row);
+}
+
+QVariant strategy_details_model::headerData(
+    int section, Qt::Orientation orientation, int role
+) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return {};
+    }
+    return section == 0 ? title : value_title;
+}
@@ -1,8 +1,12 @@
 #include "widget/table.hpp"
 #include "card_helpers/card_packer.hpp"
 #include "card_helpers/card_sheet.hpp"
+#include "helpers/session_log.hpp"
 #include "helpers/str_label.hpp"
+#include "helpers/strategy_data.hpp"
 #include "helpers/theme_settings.hpp"
+#include "helpers/trace_recorder.hpp"
+#include "widget/perf_hud.hpp"
 #include "widget/table_slot.hpp"
 
 #include <QColor>
@@ -11,30 +15,51 @@
 #include <QPainter>
 #include <QResizeEvent>
 #include <QString>
+#include <QStringList>
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
+#include <utility>
 
 table::table(BaseWidget* parent)
     : BaseWidget(parent)
     , slot_widgets()
     , swap_source_slot(nullptr)
     , copy_source_slot(nullptr)
+    , card_packer_instance()
+    , model(std::make_unique<table_model>())
     , pick_interval_ms(300)
-    , pick_elapsed_ms(0)
+    , pick_scheduler(std::make_unique<deal_scheduler>())
+    , animation_clock(std::make_unique<frame_clock>())
     , quiz_running(false)
     , quiz_paused(false)
     , allow_skipping(true)
-    , current_mode(dealing_mode::sequential)
-    , next_slot_index(0)
     , rasterizing_slots()
     , rasterization_busy(false)
-    , random_gen()
-    , preload_timer(nullptr) {
+    , session_index(0)
+    , session_seed_value(0)
+    , recorder()
+    , replay_log()
+    , replay_event_index(0)
+    , preload_timer(nullptr)
+    , hud(nullptr) {
     setMinimumHeight(88);
+    pick_scheduler->set_interval_ms(pick_interval_ms);
+    QObject::connect(
+        pick_scheduler.get(), &deal_scheduler::deal_due, this,
+        &table::on_pick_timeout
+    );
+    QObject::connect(
+        animation_clock.get(), &frame_clock::frame, this,
+        &table::on_animation_frame
+    );
 }
 
-table::~table() = default;
+table::~table() {
+    // Closing the window mid-session must not lose what was recorded.
+    finish_recording();
+}
 
 void table::set_slot_count(int count) {
     if (count < 0) {
@@ -63,7 +88,7 @@ void table::set_slot_count(int count) {
     if (count < current_count) {
         if (count == 0) {
             quiz_running = false;
-            pick_elapsed_ms = 0;
+            pick_scheduler->stop();
         }
         for (int index = count; index < current_count; ++index) {
             table_slot* slot_widget
@@ -91,6 +116,21 @@ void table::set_slot_count(int count) {
                 slot_widget, &table_slot::copy_all_clicked, this,
                 &table::on_slot_copy_all
             );
+            QObject::connect(
+                slot_widget, &table_slot::animation_started,
+                animation_clock.get(), &frame_clock::wake
+            );
+            QObject::connect(
+                slot_widget, &table_slot::availability_changed, this,
+                [this, slot_widget]() {
+                    const auto found = std::find(
+                        slot_widgets.begin(), slot_widgets.end(), slot_widget
+                    );
+                    model->refresh_slot(static_cast<int>(
+                        std::distance(slot_widgets.begin(), found)
+                    ));
+                }
+            );
             QObject::connect(
                 slot_widget, &table_slot::rasterization_busy_changed, this,
                 [this, slot_widget](bool busy) {
@@ -111,8 +151,11 @@ void table::set_slot_count(int count) {
         }
     }
 
-    if (next_slot_index >= count) {
-        next_slot_index = 0;
+    model->set_slot_count(count);
+    for (int index = current_count; index < count; ++index) {
+        slot_widgets[static_cast<std::size_t>(index)]->set_model(
+            model->slot_handle(index)
+        );
     }
 
     if (count > 0) {
@@ -126,14 +169,36 @@ void table::set_slot_count(int count) {
 }
 
 void table::start_quiz(int quiz_type_index, bool wait_for_answers) {
+    ++session_index;
+    session_seed_value = random_generator::derive_seed(
+        random_generator::master_seed(), session_index
+    );
+    replay_log.reset();
+
+    if (recorder != nullptr) {
+        session_header header;
+        header.seed = session_seed_value;
+        header.quiz_type = quiz_type_index;
+        header.dealing_mode = static_cast<int>(model->mode());
+        header.wait_for_answers = wait_for_answers;
+        recorder->begin_session(header);
+    }
+
+    std::uint64_t slot_stream = 0;
     for (table_slot* slot_widget : slot_widgets) {
+        ++slot_stream;
         if (slot_widget != nullptr) {
+            slot_widget->set_session_recorder(
+                recorder.get(), static_cast<int>(slot_stream - 1)
+            );
+            slot_widget->reseed_random(session_seed_value, slot_stream);
             slot_widget->set_allow_skipping(allow_skipping);
             slot_widget->start_quiz(quiz_type_index);
+            slot_widget->record_session_setup(slot_stream);
         }
     }
 
-    next_slot_index = 0;
+    model->start(session_seed_value);
     quiz_running = true;
     quiz_paused = wait_for_answers;
     if (quiz_paused) {
@@ -143,10 +208,89 @@ void table::start_quiz(int quiz_type_index, bool wait_for_answers) {
             }
         }
     }
-    pick_elapsed_ms = 0;
+    pick_scheduler->stop();
+    pick_scheduler->set_active(!quiz_paused);
+}
+
+void table::start_replay(const session_log& log) {
+    session_seed_value = log.header.seed;
+    set_dealing_mode(log.header.dealing_mode);
+    set_slot_count(static_cast<int>(log.slot_setups.size()));
+
+    for (const session_slot_setup& setup : log.slot_setups) {
+        if (setup.slot < 0
+            || setup.slot >= static_cast<int>(slot_widgets.size())) {
+            continue;
+        }
+        table_slot* slot_widget
+            = slot_widgets[static_cast<std::size_t>(setup.slot)];
+        if (slot_widget != nullptr) {
+            slot_widget->set_session_recorder(nullptr, setup.slot);
+            slot_widget->reseed_random(session_seed_value, setup.stream);
+            slot_widget->set_allow_skipping(true);
+            slot_widget->start_replay(log.header.quiz_type, setup);
+        }
+    }
+
+    replay_log = std::make_unique<session_log>(log);
+    replay_event_index = 0;
+    model->start(session_seed_value);
+    quiz_running = true;
+    quiz_paused = false;
+    pick_scheduler->stop();
+}
+
+bool table::is_replaying() const { return replay_log != nullptr; }
+
+QString table::strategy_comparison_report() const {
+    const std::shared_ptr<const strategy_registry> registry
+        = strategy_registry::instance();
+    const QVector<strategy_data>& strategies = registry->strategies();
+    const strategy_matrix& matrix = registry->weight_matrix();
+
+    QStringList lines;
+    std::vector<int> counts;
+    for (std::size_t index = 0; index < slot_widgets.size(); ++index) {
+        const table_slot* slot_widget = slot_widgets[index];
+        if (slot_widget == nullptr) {
+            continue;
+        }
+
+        const std::array<int, rank_counter::ranks_count> seen
+            = slot_widget->seen_rank_counts();
+        matrix.running_counts(seen, counts);
+        const QString selected = slot_widget->strategy_name();
+        lines.append(str_label("Slot %1 (%2)")
+                         .arg(static_cast<int>(index + 1))
+                         .arg(selected));
+        for (std::size_t strategy = 0; strategy < counts.size(); ++strategy) {
+            const QString& name
+                = strategies.at(static_cast<qsizetype>(strategy)).name;
+            const QString marker
+                = name == selected ? str_label("*") : QString();
+            lines.append(str_label("  %1%2: %3")
+                             .arg(name, marker)
+                             .arg(counts[strategy]));
+        }
+    }
+    return lines.join('\n');
+}
+
+void table::apply_strategy_changes(const QStringList& changed_names) {
+    for (table_slot* slot_widget : slot_widgets) {
+        if (slot_widget != nullptr) {
+            slot_widget->refresh_strategies(changed_names);
+        }
+    }
+}
+
+void table::set_session_recorder(std::shared_ptr<session_recorder> recorder) {
+    this->recorder = std::move(recorder);
 }
 
 void table::clear_quiz() {
+    finish_recording();
+    replay_log.reset();
     for (table_slot* slot_widget : slot_widgets) {
         if (slot_widget != nullptr) {
             slot_widget->clear_quiz();
@@ -155,7 +299,7 @@ void table::clear_quiz() {
 
     quiz_running = false;
     quiz_paused = false;
-    pick_elapsed_ms = 0;
+    pick_scheduler->stop();
 }
 
 void table::set_paused(bool paused) {
@@ -165,30 +309,47 @@ void table::set_paused(bool paused) {
         }
     }
 
+    if (recorder != nullptr && quiz_running && quiz_paused != paused) {
+        recorder->record(session_event_kind::paused, -1, paused ? 1 : 0);
+    }
     quiz_paused = paused;
+    pick_scheduler->set_active(
+        quiz_running && !paused && replay_log == nullptr
+    );
+    if (!paused) {
+        animation_clock->wake();
+    }
 }
 
 void table::set_pick_interval(int interval_ms) {
-    if (interval_ms < 1) {
-        interval_ms = 1;
+    const int min_interval_ms = static_cast<int>(
+        deal_timeline::min_interval_ns / 1000000
+    );
+    if (interval_ms < min_interval_ms) {
+        interval_ms = min_interval_ms;
     }
     pick_interval_ms = interval_ms;
+    pick_scheduler->set_interval_ms(interval_ms);
     if (preload_timer != nullptr && preload_timer->is_active()) {
         preload_timer->set_interval(rasterization_delay_ms());
         preload_timer->start();
     }
 }
 
+void table::set_catch_up_policy(catch_up_policy policy) {
+    pick_scheduler->set_policy(policy);
+}
+
 void table::set_dealing_mode(int mode_index) {
     switch (mode_index) {
     case 0:
-        current_mode = dealing_mode::sequential;
+        model->set_dealing_mode(table_model::dealing_mode::sequential);
         break;
     case 1:
-        current_mode = dealing_mode::random;
+        model->set_dealing_mode(table_model::dealing_mode::random);
         break;
     default:
-        current_mode = dealing_mode::simultaneous;
+        model->set_dealing_mode(table_model::dealing_mode::simultaneous);
         break;
     }
 }
@@ -203,6 +364,7 @@ void table::set_allow_skipping(bool allow) {
 }
 
 void table::paintEvent(QPaintEvent* event) {
+    const trace_zone zone("table::paintEvent", "paint");
     BaseWidget::paintEvent(event);
 
     QPainter painter(this);
@@ -254,6 +416,35 @@ void table::apply_theme() {
 
 bool table::is_rasterization_busy() const { return rasterization_busy; }
 
+int table::pick_interval() const { return pick_interval_ms; }
+
+QVector<qint64> table::slot_cache_bytes() const {
+    QVector<qint64> bytes;
+    bytes.reserve(static_cast<qsizetype>(slot_widgets.size()));
+    for (const table_slot* slot_widget : slot_widgets) {
+        if (slot_widget != nullptr && slot_widget->isVisible()) {
+            bytes.append(slot_widget->raster_cache_bytes());
+        }
+    }
+    return bytes;
+}
+
+void table::set_perf_hud_visible(bool visible) {
+    if (hud == nullptr) {
+        if (!visible) {
+            return;
+        }
+        hud = new perf_hud(this);
+    }
+    hud->setVisible(visible);
+}
+
+bool table::is_perf_hud_visible() const {
+    return hud != nullptr && hud->isVisible();
+}
+
+std::uint64_t table::session_seed() const { return session_seed_value; }
+
 void table::on_preload_tick() {
     const QSize current_size = size();
     if (current_size.isEmpty()) {
@@ -275,6 +466,7 @@ int table::rasterization_delay_ms() const {
 void table::update_layout() {
     if (!card_packer_instance)
         return;
+    const trace_zone zone("table::update_layout", "layout");
 
     const size_t slot_count = slot_widgets.size();
     if (slot_count == 0) {
@@ -373,6 +565,10 @@ void table::on_slot_swap(table_slot* slot) {
     }
 
     std::iter_swap(it_first, it_second);
+    model->swap_slots(
+        static_cast<int>(std::distance(slot_widgets.begin(), it_first)),
+        static_cast<int>(std::distance(slot_widgets.begin(), it_second))
+    );
 
     swap_source_slot->set_swap_selected(false);
     slot->set_swap_selected(false);
@@ -439,132 +635,132 @@ void table::on_slot_copy_all(table_slot* slot) {
 }
 
 void table::on_pick_timeout() {
-    if (!quiz_running) {
+    if (!quiz_running || slot_widgets.empty()) {
         return;
     }
+    const trace_zone zone("table::on_pick_timeout", "deal");
+
+    for (int slot_index : model->select_next()) {
+        table_slot* slot_widget
+            = slot_widgets[static_cast<std::size_t>(slot_index)];
+        slot_widget->advance_card();
+        slot_widget->trigger_highlight(pick_interval_ms);
+        record_pick(slot_index);
+    }
 
-    const int slot_count = static_cast<int>(slot_widgets.size());
-    if (slot_count <= 0) {
+    if (all_slots_exhausted()) {
+        handle_game_over();
+    }
+}
+
+void table::record_pick(int slot_index) {
+    if (recorder == nullptr) {
         return;
     }
 
-    if (current_mode == dealing_mode::simultaneous) {
-        for (table_slot* slot_widget : slot_widgets) {
-            if (slot_widget != nullptr && !slot_widget->is_deck_exhausted()
-                && !slot_widget->is_quiz_prompt_active()) {
-                slot_widget->advance_card();
-                slot_widget->trigger_highlight(pick_interval_ms);
-            }
-        }
-        if (all_slots_exhausted()) {
-            handle_game_over();
-        }
+    const table_slot* slot_widget
+        = slot_widgets[static_cast<std::size_t>(slot_index)];
+    recorder->record(
+        session_event_kind::pick, slot_index,
+        slot_widget->current_card_index()
+    );
+}
+
+void table::finish_recording() {
+    if (recorder == nullptr || !recorder->is_recording()) {
         return;
     }
+    recorder->record(session_event_kind::game_over, -1);
+    recorder->save();
+}
 
-    int slot_index = 0;
-    if (current_mode == dealing_mode::random) {
-        std::vector<int> eligible_slots;
-        eligible_slots.reserve(static_cast<size_t>(slot_count));
-        bool has_available_slots = false;
-        for (int index = 0; index < slot_count; ++index) {
-            table_slot* slot_widget
-                = slot_widgets[static_cast<std::size_t>(index)];
-            if (slot_widget != nullptr && !slot_widget->is_deck_exhausted()) {
-                has_available_slots = true;
-            }
-            if (slot_widget != nullptr && !slot_widget->is_deck_exhausted()
-                && !slot_widget->is_quiz_prompt_active()) {
-                eligible_slots.push_back(index);
-            }
-        }
-        if (eligible_slots.empty()) {
-            if (!has_available_slots) {
-                handle_game_over();
-            }
-            return;
+void table::advance_replay(qint64 elapsed_ms) {
+    const std::vector<session_event>& events = replay_log->events;
+    while (replay_event_index < events.size()
+           && events[replay_event_index].time_ms <= elapsed_ms) {
+        const session_event& event = events[replay_event_index];
+        ++replay_event_index;
+
+        if (event.kind == session_event_kind::game_over) {
+            break;
         }
-        const int pick_index = random_gen.uniform_int(
-            0, static_cast<int>(eligible_slots.size()) - 1
-        );
-        slot_index = eligible_slots[static_cast<std::size_t>(pick_index)];
-    } else {
-        int attempts = 0;
-        slot_index = next_slot_index;
-        while (attempts < slot_count) {
-            table_slot* slot_widget
-                = slot_widgets[static_cast<std::size_t>(slot_index)];
-            if (slot_widget != nullptr && !slot_widget->is_deck_exhausted()
-                && !slot_widget->is_quiz_prompt_active()) {
-                break;
-            }
-            slot_index = (slot_index + 1) % slot_count;
-            ++attempts;
+        if (event.slot < 0
+            || event.slot >= static_cast<int>(slot_widgets.size())) {
+            continue;
         }
-        if (attempts >= slot_count) {
-            if (all_slots_exhausted()) {
-                handle_game_over();
-            }
-            return;
+        table_slot* slot_widget
+            = slot_widgets[static_cast<std::size_t>(event.slot)];
+        if (slot_widget == nullptr) {
+            continue;
         }
-        next_slot_index = (slot_index + 1) % slot_count;
-    }
 
-    if (slot_index < 0 || slot_index >= slot_count) {
-        return;
-    }
-
-    table_slot* slot_widget
-        = slot_widgets[static_cast<std::size_t>(slot_index)];
-    if (slot_widget == nullptr) {
-        return;
+        switch (event.kind) {
+        case session_event_kind::pick:
+            slot_widget->advance_card();
+            slot_widget->trigger_highlight(pick_interval_ms);
+            break;
+        case session_event_kind::quiz_answer:
+            slot_widget->submit_quiz_answer(event.value);
+            break;
+        case session_event_kind::quiz_skip:
+            slot_widget->skip_quiz_question(event.value);
+            break;
+        case session_event_kind::quiz_continue:
+            slot_widget->continue_quiz();
+            break;
+        case session_event_kind::infinity_toggled:
+            slot_widget->set_infinity_enabled(event.value != 0);
+            break;
+        default:
+            break;
+        }
     }
-    slot_widget->advance_card();
-    slot_widget->trigger_highlight(pick_interval_ms);
 
-    if (all_slots_exhausted()) {
+    if (replay_event_index >= events.size()) {
         handle_game_over();
     }
 }
 
-void table::on_clock_tick(qint64 elapsed_ms, qint64 delta_ms) {
-    Q_UNUSED(elapsed_ms);
+void table::on_clock_tick(qint64 elapsed_ms, qint64) {
+    const trace_zone zone("table::on_clock_tick", "deal");
+    if (recorder != nullptr) {
+        recorder->set_time(elapsed_ms);
+    }
     if (!quiz_running || quiz_paused) {
         return;
     }
 
-    for (table_slot* slot_widget : slot_widgets) {
-        if (slot_widget != nullptr) {
-            slot_widget->tick_highlight(static_cast<int>(delta_ms));
-        }
-    }
-
-    pick_elapsed_ms += delta_ms;
-    while (pick_elapsed_ms >= pick_interval_ms) {
-        pick_elapsed_ms -= pick_interval_ms;
-        on_pick_timeout();
+    if (replay_log != nullptr) {
+        advance_replay(elapsed_ms);
     }
 }
 
-bool table::all_slots_exhausted() const {
-    if (slot_widgets.empty()) {
-        return false;
-    }
-
+void table::on_animation_frame(qint64 delta_ms) {
+    const bool highlights_running = quiz_running && !quiz_paused;
+    bool animating = false;
     for (table_slot* slot_widget : slot_widgets) {
-        if (slot_widget != nullptr && !slot_widget->is_deck_exhausted()) {
-            return false;
+        if (slot_widget != nullptr
+            && slot_widget->advance_animations(
+                static_cast<int>(delta_ms), highlights_running
+            )) {
+            animating = true;
         }
     }
-    return true;
+    if (!animating) {
+        animation_clock->stop();
+    }
 }
 
+bool table::all_slots_exhausted() const { return model->is_game_over(); }
+
 void table::handle_game_over() {
     if (!quiz_running) {
         return;
     }
+    finish_recording();
+    replay_log.reset();
     quiz_running = false;
     quiz_paused = false;
-    pick_elapsed_ms = 0;
+    pick_scheduler->stop();
     emit game_over();
 }
@@ -2,10 +2,12 @@
 
 #include "helpers/icon_loader.hpp"
 #include "helpers/infinity_spinbox.hpp"
+#include "helpers/session_log.hpp"
 #include "helpers/str_label.hpp"
 #include "helpers/strategy_data.hpp"
 #include "helpers/theme_palette.hpp"
 #include "helpers/theme_settings.hpp"
+#include "helpers/trace_recorder.hpp"
 #include "widget/card_widget.hpp"
 #include "widget/settings_template.hpp"
 #include "widget/slot_settings.hpp"
@@ -23,17 +25,12 @@
 #include <QtGlobal>
 
 #include <algorithm>
+#include <utility>
 
 namespace {
 
 QVector<int> weights_for_strategy_name(const QString& strategy_name) {
-    const QVector<strategy_data> strategies = load_strategies();
-    for (const auto& strategy : strategies) {
-        if (strategy.name == strategy_name) {
-            return strategy.weights;
-        }
-    }
-    return {};
+    return strategy_registry::instance()->weights_for_name(strategy_name);
 }
 
 }
@@ -72,12 +69,16 @@ table_slot::table_slot(BaseWidget* parent)
     , is_rotated(false)
     , use_dialog_for_settings(false)
     , deck_count_minimum(1)
-    , quiz_prompt_active(false)
     , quiz_feedback_active(false)
     , quiz_continue_visible(false)
     , allow_skipping_flag(true)
-    , last_quiz_input_value(0) {
+    , last_quiz_input_value(0)
+    , recorder(nullptr)
+    , recorder_slot_index(-1) {
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    card_widget_internal->model().set_checkpoint_interval(
+        slot_model::default_checkpoint_interval
+    );
     card_widget_internal->setSizePolicy(
         QSizePolicy::Expanding, QSizePolicy::Expanding
     );
@@ -85,6 +86,10 @@ table_slot::table_slot(BaseWidget* parent)
         card_widget_internal, &card_widget::rasterization_busy_changed, this,
         &table_slot::rasterization_busy_changed
     );
+    QObject::connect(
+        card_widget_internal, &card_widget::animation_started, this,
+        &table_slot::animation_started
+    );
     setup_overlay();
     card_widget_internal->show();
 }
@@ -126,6 +131,157 @@ void table_slot::set_allow_skipping(bool allow) {
     update_quiz_controls_visibility();
 }
 
+void table_slot::reseed_random(std::uint64_t seed, std::uint64_t stream) {
+    if (card_widget_internal == nullptr) {
+        return;
+    }
+    card_widget_internal->reseed_random(seed, stream);
+}
+
+void table_slot::set_shoe_bank(std::shared_ptr<shoe_bank> bank) {
+    if (card_widget_internal == nullptr) {
+        return;
+    }
+    card_widget_internal->set_shoe_bank(std::move(bank));
+}
+
+void table_slot::set_model(std::shared_ptr<slot_model> model) {
+    if (card_widget_internal == nullptr || model == nullptr) {
+        return;
+    }
+    card_widget_internal->set_model(std::move(model));
+    sync_card_display_settings();
+    update_overlay_layout();
+    set_paused(current_phase == slot_phase::paused);
+}
+
+void table_slot::start_replay(
+    int quiz_type_index, const session_slot_setup& setup
+) {
+    if (deck_count_spin_box != nullptr) {
+        deck_count_spin_box->setValue(setup.decks_count);
+    }
+    set_infinity_enabled(setup.infinity);
+    start_quiz(quiz_type_index);
+    if (card_widget_internal != nullptr) {
+        card_widget_internal->set_strategy_weights(
+            QVector<int>(setup.weights.begin(), setup.weights.end())
+        );
+    }
+}
+
+void table_slot::set_session_recorder(
+    session_recorder* recorder, int slot_index
+) {
+    this->recorder = recorder;
+    recorder_slot_index = slot_index;
+}
+
+void table_slot::record_session_setup(std::uint64_t stream) const {
+    if (recorder == nullptr || card_widget_internal == nullptr) {
+        return;
+    }
+
+    session_slot_setup setup;
+    setup.slot = recorder_slot_index;
+    setup.stream = stream;
+    setup.cards_per_deck = card_widget_internal->cards_in_deck();
+    setup.decks_count = deck_count_spin_box != nullptr
+        ? std::max(1, deck_count_spin_box->value())
+        : 1;
+    setup.infinity = is_infinity_enabled();
+    const QVector<int>& weights
+        = card_widget_internal->strategy_weight_values();
+    setup.weights.assign(weights.begin(), weights.end());
+    recorder->add_slot(setup);
+}
+
+void table_slot::submit_quiz_answer(int provided) {
+    if (!is_quiz_prompt_active()) {
+        return;
+    }
+    const trace_zone zone("table_slot::submit_quiz_answer", "quiz");
+    slot_model& model = card_widget_internal->model();
+    const int expected = model.running_count();
+    last_quiz_input_value = provided;
+    if (quiz_spin_box != nullptr) {
+        quiz_spin_box->setValue(provided);
+    }
+    const bool training_enabled = is_training_enabled();
+    if (recorder != nullptr) {
+        recorder->record(
+            session_event_kind::quiz_answer, recorder_slot_index, provided,
+            expected, training_enabled
+        );
+    }
+    const slot_score before = model.score();
+    const slot_model::answer_outcome outcome = model.submit_answer(provided);
+    emit_score_change(before);
+    if (outcome == slot_model::answer_outcome::correct) {
+        clear_quiz_prompt();
+        return;
+    }
+    const QString message
+        = str_label("You've set %1 while the correct answer is %2.")
+              .arg(provided)
+              .arg(expected);
+    if (outcome == slot_model::answer_outcome::wrong) {
+        show_quiz_feedback(message, true);
+        return;
+    }
+    card_widget_internal->update();
+    show_quiz_feedback(message, false);
+    emit availability_changed();
+}
+
+void table_slot::skip_quiz_question(int provided) {
+    if (!is_quiz_prompt_active()) {
+        return;
+    }
+    const trace_zone zone("table_slot::skip_quiz_question", "quiz");
+    slot_model& model = card_widget_internal->model();
+    const int expected = model.running_count();
+    last_quiz_input_value = provided;
+    if (quiz_spin_box != nullptr) {
+        quiz_spin_box->setValue(provided);
+    }
+    const bool training_enabled = is_training_enabled();
+    if (recorder != nullptr) {
+        recorder->record(
+            session_event_kind::quiz_skip, recorder_slot_index, provided,
+            expected, training_enabled
+        );
+    }
+    const slot_score before = model.score();
+    model.skip_question();
+    emit_score_change(before);
+    const QString message
+        = str_label("You've set %1 while the correct answer is %2.")
+              .arg(provided)
+              .arg(expected);
+    show_quiz_feedback(message, true);
+}
+
+void table_slot::continue_quiz() {
+    if (!is_quiz_prompt_active()) {
+        return;
+    }
+    const trace_zone zone("table_slot::continue_quiz", "quiz");
+    if (recorder != nullptr) {
+        recorder->record(
+            session_event_kind::quiz_continue, recorder_slot_index
+        );
+    }
+    card_widget_internal->model().continue_quiz();
+    clear_quiz_prompt();
+}
+
+void table_slot::set_infinity_enabled(bool enabled) {
+    if (infinity_check_box != nullptr) {
+        infinity_check_box->setChecked(enabled);
+    }
+}
+
 void table_slot::start_quiz(int quiz_type_index) {
     int decks_count = 1;
     if (deck_count_spin_box != nullptr) {
@@ -142,7 +298,6 @@ void table_slot::start_quiz(int quiz_type_index) {
         );
     }
 
-    quiz_prompt_active = false;
     quiz_feedback_active = false;
     quiz_continue_visible = false;
     last_quiz_input_value = 0;
@@ -159,6 +314,7 @@ void table_slot::start_quiz(int quiz_type_index) {
 
     sync_card_display_settings();
     set_paused(false);
+    emit availability_changed();
 }
 
 void table_slot::clear_quiz() {
@@ -169,7 +325,6 @@ void table_slot::clear_quiz() {
             str_label("assets/cuckoo.svg")
         );
     }
-    quiz_prompt_active = false;
     quiz_feedback_active = false;
     quiz_continue_visible = false;
     last_quiz_input_value = 0;
@@ -178,6 +333,7 @@ void table_slot::clear_quiz() {
         quiz_bar_widget->hide();
     }
     set_paused(true);
+    emit availability_changed();
 }
 
 void table_slot::set_paused(bool paused) {
@@ -187,7 +343,8 @@ void table_slot::set_paused(bool paused) {
 
     const bool has_deck
         = card_widget_internal != nullptr && card_widget_internal->has_cards();
-    const bool show_overlay = paused || !has_deck || quiz_prompt_active;
+    const bool prompt_active = is_quiz_prompt_active();
+    const bool show_overlay = paused || !has_deck || prompt_active;
 
     if (overlay_widget != nullptr) {
         overlay_widget->setVisible(show_overlay);
@@ -200,16 +357,16 @@ void table_slot::set_paused(bool paused) {
     if (settings_bar_widget != nullptr) {
         const bool can_show_settings_inline = show_overlay
             && settings_overlay_visible && !use_dialog_for_settings
-            && !quiz_prompt_active;
+            && !prompt_active;
         settings_bar_widget->setVisible(can_show_settings_inline);
     }
 
     if (swap_bar_widget != nullptr) {
-        swap_bar_widget->setVisible(show_overlay && !quiz_prompt_active);
+        swap_bar_widget->setVisible(show_overlay && !prompt_active);
     }
 
     if (quiz_bar_widget != nullptr) {
-        quiz_bar_widget->setVisible(show_overlay && quiz_prompt_active);
+        quiz_bar_widget->setVisible(show_overlay && prompt_active);
     }
 
     if (swap_button != nullptr) {
@@ -250,16 +407,19 @@ void table_slot::set_paused(bool paused) {
 }
 
 void table_slot::advance_card() {
-    if (current_phase != slot_phase::running || quiz_prompt_active) {
+    if (current_phase != slot_phase::running || card_widget_internal == nullptr
+        || is_quiz_prompt_active()) {
         return;
     }
 
-    if (card_widget_internal != nullptr) {
-        card_widget_internal->advance_card();
-        const int current_position = card_widget_internal->current_position();
-        if (current_position >= 0 && (current_position + 1) % 30 == 0) {
-            show_quiz_prompt();
-        }
+    const slot_model& model = card_widget_internal->model();
+    const slot_score before = model.score();
+    card_widget_internal->advance_card();
+    emit_score_change(before);
+    if (model.is_prompt_active()) {
+        show_quiz_prompt();
+    } else if (model.is_exhausted()) {
+        emit availability_changed();
     }
 }
 
@@ -269,10 +429,24 @@ void table_slot::trigger_highlight(int duration_ms) {
     }
 }
 
-void table_slot::tick_highlight(int delta_ms) {
-    if (card_widget_internal != nullptr) {
-        card_widget_internal->tick_highlight(delta_ms);
+bool table_slot::advance_animations(int delta_ms, bool highlights_running) {
+    if (card_widget_internal == nullptr) {
+        return false;
     }
+    return card_widget_internal->advance_animations(
+        delta_ms, highlights_running
+    );
+}
+
+bool table_slot::is_animating(bool highlights_running) const {
+    return card_widget_internal != nullptr
+        && card_widget_internal->is_animating(highlights_running);
+}
+
+qint64 table_slot::raster_cache_bytes() const {
+    return card_widget_internal != nullptr
+        ? card_widget_internal->raster_cache_bytes()
+        : 0;
 }
 
 void table_slot::prepare_card_faces() {
@@ -486,61 +660,21 @@ void table_slot::setup_overlay() {
     );
     QObject::connect(
         quiz_answer_button, &BasePushButton::clicked, this, [this]() {
-            if (!quiz_prompt_active || quiz_spin_box == nullptr
-                || card_widget_internal == nullptr) {
-                return;
-            }
-            const int expected = card_widget_internal->current_total_weight();
-            const int provided = quiz_spin_box->value();
-            last_quiz_input_value = provided;
-            const bool training_enabled = is_training_enabled();
-            if (provided == expected) {
-                if (!training_enabled) {
-                    emit score_adjusted(1, 0);
-                }
-                clear_quiz_prompt();
-                return;
-            }
-            const QString message
-                = str_label("You've set %1 while the correct answer is %2.")
-                      .arg(provided)
-                      .arg(expected);
-            if (training_enabled) {
-                show_quiz_feedback(message, true);
-                return;
-            }
-            if (card_widget_internal != nullptr) {
-                card_widget_internal->mark_deck_exhausted();
+            if (quiz_spin_box != nullptr) {
+                submit_quiz_answer(quiz_spin_box->value());
             }
-            show_quiz_feedback(message, false);
         }
     );
     QObject::connect(
         quiz_skip_button, &BasePushButton::clicked, this, [this]() {
-            if (!quiz_prompt_active || quiz_spin_box == nullptr
-                || card_widget_internal == nullptr) {
-                return;
+            if (quiz_spin_box != nullptr) {
+                skip_quiz_question(quiz_spin_box->value());
             }
-            const int expected = card_widget_internal->current_total_weight();
-            const int provided = quiz_spin_box->value();
-            last_quiz_input_value = provided;
-            if (!is_training_enabled()) {
-                emit score_adjusted(0, -1);
-            }
-            const QString message
-                = str_label("You've set %1 while the correct answer is %2.")
-                      .arg(provided)
-                      .arg(expected);
-            show_quiz_feedback(message, true);
         }
     );
     QObject::connect(
-        quiz_continue_button, &BasePushButton::clicked, this, [this]() {
-            if (!quiz_prompt_active) {
-                return;
-            }
-            clear_quiz_prompt();
-        }
+        quiz_continue_button, &BasePushButton::clicked, this,
+        &table_slot::continue_quiz
     );
     QObject::connect(
         show_card_indexing, &BaseCheckBox::toggled, this, [this](bool checked) {
@@ -650,7 +784,7 @@ void table_slot::update_overlay_layout() {
         is_rotated ? QBoxLayout::LeftToRight : QBoxLayout::TopToBottom
     );
 
-    if (quiz_prompt_active) {
+    if (is_quiz_prompt_active()) {
         overlay_layout->addStretch();
         overlay_layout->addWidget(quiz_bar_widget, 0, Qt::AlignCenter);
         overlay_layout->addStretch();
@@ -762,7 +896,14 @@ void table_slot::on_infinity_toggled(bool checked) {
     if (card_widget_internal != nullptr) {
         card_widget_internal->set_infinity(is_infinity);
     }
+    if (recorder != nullptr) {
+        recorder->record(
+            session_event_kind::infinity_toggled, recorder_slot_index,
+            is_infinity ? 1 : 0
+        );
+    }
     update_lockable_settings();
+    emit availability_changed();
 }
 
 void table_slot::on_swap_button_clicked() { emit swap_clicked(this); }
@@ -926,10 +1067,7 @@ bool table_slot::is_training_enabled() const {
 }
 
 void table_slot::show_quiz_prompt() {
-    if (quiz_prompt_active) {
-        return;
-    }
-    quiz_prompt_active = true;
+    const trace_zone zone("table_slot::show_quiz_prompt", "quiz");
     quiz_feedback_active = false;
     quiz_continue_visible = false;
     update_overlay_layout();
@@ -949,17 +1087,11 @@ void table_slot::show_quiz_prompt() {
             str_label("assets/mad.svg")
         );
     }
-    if (!is_training_enabled()) {
-        emit score_adjusted(0, 1);
-    }
     set_paused(current_phase == slot_phase::paused);
+    emit availability_changed();
 }
 
 void table_slot::clear_quiz_prompt() {
-    if (!quiz_prompt_active) {
-        return;
-    }
-    quiz_prompt_active = false;
     quiz_feedback_active = false;
     quiz_continue_visible = false;
     update_overlay_layout();
@@ -974,6 +1106,7 @@ void table_slot::clear_quiz_prompt() {
         );
     }
     set_paused(current_phase == slot_phase::paused);
+    emit availability_changed();
 }
 
 void table_slot::show_quiz_feedback(
@@ -1088,7 +1221,42 @@ bool table_slot::is_deck_exhausted() const {
         && card_widget_internal->is_deck_exhausted();
 }
 
-bool table_slot::is_quiz_prompt_active() const { return quiz_prompt_active; }
+int table_slot::current_card_index() const {
+    if (card_widget_internal == nullptr) {
+        return -1;
+    }
+    return card_widget_internal->current_card_index();
+}
+
+std::array<int, rank_counter::ranks_count>
+table_slot::seen_rank_counts() const {
+    if (card_widget_internal == nullptr) {
+        return {};
+    }
+    return card_widget_internal->seen_rank_counts();
+}
+
+QString table_slot::strategy_name() const {
+    if (strategy_combo_box == nullptr) {
+        return {};
+    }
+    return strategy_combo_box->currentText();
+}
+
+bool table_slot::is_quiz_prompt_active() const {
+    return card_widget_internal != nullptr
+        && card_widget_internal->model().is_prompt_active();
+}
+
+void table_slot::emit_score_change(const slot_score& before) {
+    const slot_score& after = card_widget_internal->model().score();
+    if (after.correct == before.correct && after.total == before.total) {
+        return;
+    }
+    emit score_adjusted(
+        after.correct - before.correct, after.total - before.total
+    );
+}
 
 void table_slot::sync_card_display_settings() {
     if (card_widget_internal == nullptr) {
@@ -1142,9 +1310,11 @@ void table_slot::show_template_dialog(
     dialog.setWindowTitle(title);
 
     auto dialog_layout = new QVBoxLayout(&dialog);
-    dialog_layout->addWidget(new settings_template_widget(
+    auto details = new settings_template_widget(
         settings_tab_kind::strategies, &dialog, strategy_name
-    ));
+    );
+    details->ensure_ui();
+    dialog_layout->addWidget(details);
 
     auto button_box = new QDialogButtonBox(QDialogButtonBox::Close, &dialog);
     QObject::connect(
@@ -1155,6 +1325,21 @@ void table_slot::show_template_dialog(
     dialog.exec();
 }
 
+void table_slot::refresh_strategies(const QStringList& changed_names) {
+    if (strategy_combo_box == nullptr || card_widget_internal == nullptr) {
+        return;
+    }
+
+    const QString previous = strategy_combo_box->currentText();
+    slot_settings::fill_strategy_names(strategy_combo_box);
+    const QString current = strategy_combo_box->currentText();
+    if (current == previous && !changed_names.contains(current)) {
+        return;
+    }
+    card_widget_internal->set_strategy_name(current);
+    update_strategy_weights(current);
+}
+
 void table_slot::update_strategy_weights(const QString& strategy_name) {
     if (card_widget_internal == nullptr) {
         return;
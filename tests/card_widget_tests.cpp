@@ -1,5 +1,8 @@
 #include "include/card_widget_tests.hpp"
 
+#include "card_helpers/shoe_bank.hpp"
+#include "card_helpers/strategy_matrix.hpp"
+#include "helpers/strategy_data.hpp"
 #include "widget/card_widget.hpp"
 
 #include <QtTest/QtTest>
@@ -9,6 +12,22 @@ qint64 pixel_area(const QSize& size) {
     return static_cast<qint64>(size.width())
         * static_cast<qint64>(size.height());
 }
+
+int brute_force_weight(const card_picker& picker, const QVector<int>& weights) {
+    const int current_position = picker.current_position();
+    int total = 0;
+    for (int position = 0; position <= current_position; ++position) {
+        const int card_index = picker.card_index_at(position);
+        if (card_index < 0 || card_index >= 52) {
+            continue;
+        }
+        const int rank_index = card_index % 13;
+        if (rank_index < weights.size()) {
+            total += weights.at(rank_index);
+        }
+    }
+    return total;
+}
 } // namespace
 
 void card_widget_tests::stretches_between_raster_intervals() {
@@ -84,3 +103,152 @@ void card_widget_tests::memory_cache_tracks_resize() {
         "resizing up should increase raster cache size"
     );
 }
+
+void card_widget_tests::running_count_tracks_dealt_cards() {
+    const QVector<int> hi_lo = { -1, 1, 1, 1, 1, 1, 0, 0, 0, -1, -1, -1, -1 };
+    const QVector<int> zen = { -1, 1, 1, 2, 2, 2, 1, 0, 0, -2, -2, -2, -2 };
+
+    card_widget widget;
+    widget.set_strategy_weights(hi_lo);
+    widget.start_quiz(1, 1, true);
+    widget.set_running(true);
+
+    const int total_cards = widget.model().picker().total_cards();
+    for (int pick = 0; pick < total_cards * 2 + 7; ++pick) {
+        QCOMPARE(
+            widget.current_total_weight(),
+            brute_force_weight(widget.model().picker(), hi_lo)
+        );
+        if (pick == total_cards / 2) {
+            widget.set_strategy_weights(zen);
+            QCOMPARE(
+                widget.current_total_weight(),
+                brute_force_weight(widget.model().picker(), zen)
+            );
+            widget.set_strategy_weights(hi_lo);
+        }
+        widget.advance_card();
+    }
+
+    widget.mark_deck_exhausted();
+    QCOMPARE(widget.current_total_weight(), 0);
+}
+
+void card_widget_tests::reseeded_slots_deal_identically() {
+    card_widget first;
+    card_widget second;
+    card_widget other_stream;
+    first.reseed_random(42, 3);
+    second.reseed_random(42, 3);
+    other_stream.reseed_random(42, 4);
+    for (card_widget* widget : { &first, &second, &other_stream }) {
+        widget->start_quiz(0, 2, false);
+        widget->set_running(true);
+    }
+    QCOMPARE(first.card_rotation_deg, second.card_rotation_deg);
+
+    const int total_cards = first.model().picker().total_cards();
+    QCOMPARE(second.model().picker().total_cards(), total_cards);
+    bool differs = false;
+    for (int pick = 0; pick < total_cards; ++pick) {
+        const int card_index = first.model().picker().current_card_index();
+        QCOMPARE(second.model().picker().current_card_index(), card_index);
+        differs = differs
+            || other_stream.model().picker().current_card_index() != card_index;
+        for (card_widget* widget : { &first, &second, &other_stream }) {
+            widget->advance_card();
+        }
+    }
+    QVERIFY2(differs, "different streams dealt the same shoe");
+
+    random_generator generator(7, 11);
+    for (int draw = 0; draw < 1000; ++draw) {
+        const int value = generator.uniform_int(-3, 5);
+        QVERIFY(value >= -3 && value <= 5);
+    }
+}
+
+void card_widget_tests::shared_shoe_bank_tracks_remaining_ranks() {
+    auto bank = std::make_shared<shoe_bank>();
+    card_widget first;
+    card_widget second;
+    first.set_shoe_bank(bank);
+    second.set_shoe_bank(bank);
+    QCOMPARE(bank->slot_count(), 2);
+
+    first.start_quiz(0, 2, false);
+    second.start_quiz(0, 4, true);
+    first.set_running(true);
+    second.set_running(true);
+    QCOMPARE(
+        bank->buffer_size(),
+        static_cast<std::size_t>(
+            first.model().picker().total_cards()
+            + second.model().picker().total_cards()
+        )
+    );
+
+    for (card_widget* widget : { &first, &second }) {
+        const card_picker& picker = widget->model().picker();
+        const int total_cards = picker.total_cards();
+        for (int pick = 0; pick < total_cards + 3; ++pick) {
+            int remaining = 0;
+            for (int bucket = 0; bucket < shoe_bank::rank_buckets; ++bucket) {
+                remaining += picker.remaining_of_rank(bucket);
+            }
+            const int position = picker.current_position();
+            QCOMPARE(remaining, position < 0 ? 0 : total_cards - position - 1);
+            widget->advance_card();
+        }
+    }
+    QVERIFY(first.is_deck_exhausted());
+    QVERIFY(!second.is_deck_exhausted());
+}
+
+void card_widget_tests::strategy_matrix_matches_single_counts() {
+    const QVector<strategy_data> strategies
+        = strategy_registry::instance()->strategies();
+    const strategy_matrix& matrix
+        = strategy_registry::instance()->weight_matrix();
+    QCOMPARE(
+        static_cast<qsizetype>(matrix.strategies_count()), strategies.size()
+    );
+
+    card_widget widget;
+    widget.start_quiz(1, 2, false);
+    widget.set_running(true);
+    for (int pick = 0; pick < 61; ++pick) {
+        widget.advance_card();
+    }
+
+    const std::vector<int> counts
+        = matrix.running_counts(widget.seen_rank_counts());
+    for (qsizetype index = 0; index < strategies.size(); ++index) {
+        widget.set_strategy_weights(strategies.at(index).weights);
+        QCOMPARE(
+            counts[static_cast<std::size_t>(index)],
+            widget.current_total_weight()
+        );
+    }
+}
+
+void card_widget_tests::animations_settle_when_idle() {
+    card_widget widget;
+    QSignalSpy started(&widget, &card_widget::animation_started);
+    QVERIFY(!widget.is_animating(true));
+
+    widget.trigger_highlight(100);
+    QCOMPARE(started.count(), 1);
+    QVERIFY(!widget.advance_animations(60, false));
+    QVERIFY(widget.highlight_active);
+    QVERIFY(widget.advance_animations(60, true));
+    QVERIFY(!widget.advance_animations(60, true));
+    QVERIFY(!widget.highlight_active);
+
+    widget.set_swap_selected(true);
+    QCOMPARE(started.count(), 2);
+    QVERIFY(widget.advance_animations(1000, false));
+    QVERIFY(widget.selection_phase < 6.283);
+    widget.set_swap_selected(false);
+    QVERIFY(!widget.advance_animations(16, true));
+}
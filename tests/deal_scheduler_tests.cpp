@@ -0,0 +1,33 @@
+#include "include/deal_scheduler_tests.hpp"
+#include "helpers/deal_scheduler.hpp"
+
+#include <QtTest/QtTest>
+
+#include <cstdint>
+
+void deal_scheduler_tests::deal_timeline_stays_on_grid() {
+    const std::int64_t ms = 1000000;
+    deal_timeline timeline;
+    timeline.set_interval(20 * ms, 0);
+    timeline.start(0);
+    for (int wakeup = 0; wakeup < 10000; ++wakeup) {
+        QCOMPARE(timeline.take_due(timeline.next_deadline() + ms), 1);
+    }
+    QCOMPARE(timeline.next_deadline(), 10001 * 20 * ms);
+
+    timeline.set_policy(catch_up_policy::burst);
+    const std::int64_t late = timeline.next_deadline() + 110 * ms;
+    QCOMPARE(timeline.take_due(late), deal_timeline::max_burst);
+    QCOMPARE(timeline.take_due(late), 2);
+    QCOMPARE(timeline.take_due(late), 0);
+
+    timeline.set_policy(catch_up_policy::drop);
+    const std::int64_t skipped = timeline.next_deadline() + 50 * ms;
+    QCOMPARE(timeline.take_due(skipped), 1);
+    QCOMPARE(timeline.next_deadline() % (20 * ms), std::int64_t { 0 });
+
+    timeline.set_policy(catch_up_policy::stretch);
+    const std::int64_t stretched = timeline.next_deadline() + 7 * ms;
+    QCOMPARE(timeline.take_due(stretched), 1);
+    QCOMPARE(timeline.next_deadline(), stretched + 20 * ms);
+}
@@ -9,6 +9,11 @@ class card_widget_tests : public QObject {
 private slots:
     void stretches_between_raster_intervals();
     void memory_cache_tracks_resize();
+    void running_count_tracks_dealt_cards();
+    void reseeded_slots_deal_identically();
+    void shared_shoe_bank_tracks_remaining_ranks();
+    void strategy_matrix_matches_single_counts();
+    void animations_settle_when_idle();
 };
 
 #endif // KCUCKOUNTER_CARD_WIDGET_TESTS_HPP
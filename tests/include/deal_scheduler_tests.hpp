@@ -0,0 +1,14 @@
+#ifndef KCUCKOUNTER_DEAL_SCHEDULER_TESTS_HPP
+#define KCUCKOUNTER_DEAL_SCHEDULER_TESTS_HPP
+
+#include <QObject>
+
+class deal_scheduler_tests : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// @brief Verifies deal deadlines do not drift and honour catch-up policy.
+    void deal_timeline_stays_on_grid();
+};
+
+#endif // KCUCKOUNTER_DEAL_SCHEDULER_TESTS_HPP
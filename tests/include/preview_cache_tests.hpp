@@ -0,0 +1,16 @@
+#ifndef KCUCKOUNTER_PREVIEW_CACHE_TESTS_HPP
+#define KCUCKOUNTER_PREVIEW_CACHE_TESTS_HPP
+
+#include <QObject>
+
+class preview_cache_tests : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// @brief Verifies sizes round up to the bucket grid keeping the aspect.
+    void bucket_rounds_up_and_keeps_aspect();
+    /// @brief Verifies sizes in one bucket share a render and others miss.
+    void hits_are_shared_within_bucket();
+};
+
+#endif // KCUCKOUNTER_PREVIEW_CACHE_TESTS_HPP
@@ -0,0 +1,14 @@
+#ifndef KCUCKOUNTER_SLOT_INDEX_SET_TESTS_HPP
+#define KCUCKOUNTER_SLOT_INDEX_SET_TESTS_HPP
+
+#include <QObject>
+
+class slot_index_set_tests : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// @brief Verifies the slot index set keeps members and index order.
+    void tracks_members();
+};
+
+#endif // KCUCKOUNTER_SLOT_INDEX_SET_TESTS_HPP
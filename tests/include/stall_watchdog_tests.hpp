@@ -0,0 +1,14 @@
+#ifndef KCUCKOUNTER_STALL_WATCHDOG_TESTS_HPP
+#define KCUCKOUNTER_STALL_WATCHDOG_TESTS_HPP
+
+#include <QObject>
+
+class stall_watchdog_tests : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// @brief Verifies a blocked tracked thread is blamed on its zone.
+    void blames_stall_on_active_zone();
+};
+
+#endif // KCUCKOUNTER_STALL_WATCHDOG_TESTS_HPP
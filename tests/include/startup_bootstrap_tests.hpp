@@ -0,0 +1,22 @@
+#ifndef KCUCKOUNTER_STARTUP_BOOTSTRAP_TESTS_HPP
+#define KCUCKOUNTER_STARTUP_BOOTSTRAP_TESTS_HPP
+
+#include <QObject>
+
+class startup_bootstrap_tests : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// @brief Verifies GUI stages are queued rather than run inside start().
+    void gui_stages_run_queued();
+    /// @brief Verifies pool stages run on a thread other than the GUI one.
+    void pool_stages_run_off_thread();
+    /// @brief Verifies a stage starts only after all its dependencies.
+    void stages_wait_for_all_dependencies();
+    /// @brief Verifies a deferred stage finishes only when done is called.
+    void deferred_stage_waits_for_done();
+    /// @brief Verifies finished() fires once, even for late stages.
+    void finished_fires_once();
+};
+
+#endif // KCUCKOUNTER_STARTUP_BOOTSTRAP_TESTS_HPP
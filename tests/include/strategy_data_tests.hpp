@@ -0,0 +1,14 @@
+#ifndef KCUCKOUNTER_STRATEGY_DATA_TESTS_HPP
+#define KCUCKOUNTER_STRATEGY_DATA_TESTS_HPP
+
+#include <QObject>
+
+class strategy_data_tests : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// @brief Verifies the generated strategy table matches the JSON.
+    void bundled_table_matches_json();
+};
+
+#endif // KCUCKOUNTER_STRATEGY_DATA_TESTS_HPP
@@ -0,0 +1,14 @@
+#ifndef KCUCKOUNTER_STRATEGY_SIMULATOR_TESTS_HPP
+#define KCUCKOUNTER_STRATEGY_SIMULATOR_TESTS_HPP
+
+#include <QObject>
+
+class strategy_simulator_tests : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// @brief Verifies simulated Hi-Lo metrics match the published ones.
+    void matches_published_hi_lo();
+};
+
+#endif // KCUCKOUNTER_STRATEGY_SIMULATOR_TESTS_HPP
@@ -0,0 +1,14 @@
+#ifndef KCUCKOUNTER_TABLE_MODEL_TESTS_HPP
+#define KCUCKOUNTER_TABLE_MODEL_TESTS_HPP
+
+#include <QObject>
+
+class table_model_tests : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// @brief Verifies the table model plays a full game without widgets.
+    void plays_headless();
+};
+
+#endif // KCUCKOUNTER_TABLE_MODEL_TESTS_HPP
@@ -25,6 +25,12 @@ private slots:
     void quiz_skip_shows_continue_feedback();
     /// @brief Verifies quiz spin box remembers the last input.
     void quiz_spin_box_remembers_last_input();
+    /// @brief Verifies a recorded session replays headless without drift.
+    void recorded_session_replays_headless();
+    /// @brief Verifies sessions append to one file and flush on close.
+    void recorded_sessions_append_and_flush_on_close();
+    /// @brief Verifies edited user strategies reach only affected slots.
+    void user_strategy_edits_reload_live();
 };
 
 #endif // KCUCKOUNTER_TABLE_TESTS_HPP
@@ -0,0 +1,18 @@
+#ifndef KCUCKOUNTER_TRACE_RECORDER_TESTS_HPP
+#define KCUCKOUNTER_TRACE_RECORDER_TESTS_HPP
+
+#include <QObject>
+
+class trace_recorder_tests : public QObject {
+    Q_OBJECT
+
+private slots:
+    /// @brief Verifies nothing is recorded while the recorder is disabled.
+    void disabled_records_nothing();
+    /// @brief Verifies nested zones and counters export as Chrome JSON.
+    void zones_and_counters_export_as_json();
+    /// @brief Verifies the event buffer stops growing at max_events.
+    void event_buffer_is_capped();
+};
+
+#endif // KCUCKOUNTER_TRACE_RECORDER_TESTS_HPP
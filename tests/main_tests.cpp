@@ -4,8 +4,17 @@
 #include "include/card_packer_tests.hpp"
 #include "include/card_sheet_tests.hpp"
 #include "include/card_widget_tests.hpp"
+#include "include/deal_scheduler_tests.hpp"
 #include "include/infinity_spinbox_tests.hpp"
+#include "include/preview_cache_tests.hpp"
+#include "include/slot_index_set_tests.hpp"
+#include "include/stall_watchdog_tests.hpp"
+#include "include/startup_bootstrap_tests.hpp"
+#include "include/strategy_data_tests.hpp"
+#include "include/strategy_simulator_tests.hpp"
+#include "include/table_model_tests.hpp"
 #include "include/table_tests.hpp"
+#include "include/trace_recorder_tests.hpp"
 
 int main(int argc, char** argv) {
     QApplication app(argc, argv);
@@ -24,14 +33,50 @@ int main(int argc, char** argv) {
         card_widget_tests t;
         status |= QTest::qExec(&t, argc, argv);
     }
+    {
+        deal_scheduler_tests t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
     {
         infinity_spinbox_tests t;
         status |= QTest::qExec(&t, argc, argv);
     }
+    {
+        preview_cache_tests t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
+    {
+        slot_index_set_tests t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
+    {
+        stall_watchdog_tests t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
+    {
+        startup_bootstrap_tests t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
+    {
+        strategy_data_tests t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
+    {
+        strategy_simulator_tests t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
+    {
+        table_model_tests t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
     {
         table_tests t;
         status |= QTest::qExec(&t, argc, argv);
     }
+    {
+        trace_recorder_tests t;
+        status |= QTest::qExec(&t, argc, argv);
+    }
 
     return status;
 }
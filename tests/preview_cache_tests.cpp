@@ -0,0 +1,47 @@
+#include "include/preview_cache_tests.hpp"
+#include "helpers/preview_cache.hpp"
+
+#include <QScopeGuard>
+#include <QtTest/QtTest>
+
+#include <cmath>
+
+void preview_cache_tests::bucket_rounds_up_and_keeps_aspect() {
+    QCOMPARE(preview_cache::bucket_size(QSize(100, 140)), QSize(112, 157));
+    QCOMPARE(preview_cache::bucket_size(QSize(97, 97)), QSize(112, 112));
+    QCOMPARE(preview_cache::bucket_size(QSize(96, 50)), QSize(96, 50));
+    QCOMPARE(preview_cache::bucket_size(QSize(1, 1)), QSize(16, 16));
+    QCOMPARE(preview_cache::bucket_size(QSize(8, 0)), QSize(16, 1));
+
+    const QSize bucket = preview_cache::bucket_size(QSize(250, 350));
+    QCOMPARE(bucket.width() % preview_cache::size_bucket_px, 0);
+    QVERIFY(bucket.width() >= 250);
+    QVERIFY(
+        std::abs(bucket.height() * 250.0 / bucket.width() - 350.0) < 1.0
+    );
+}
+
+void preview_cache_tests::hits_are_shared_within_bucket() {
+    preview_cache& cache = preview_cache::instance();
+    cache.clear();
+    const auto clear_cache = qScopeGuard([&cache]() { cache.clear(); });
+
+    const QString tag = QStringLiteral("test");
+    QPixmap render(preview_cache::bucket_size(QSize(100, 140)));
+    render.fill(Qt::red);
+    cache.insert(tag, 3, QSize(100, 140), render);
+
+    for (const QSize& size : { QSize(100, 140), QSize(105, 147),
+                               QSize(112, 157) }) {
+        const QPixmap hit = cache.find(tag, 3, size);
+        QVERIFY(!hit.isNull());
+        QCOMPARE(hit.cacheKey(), render.cacheKey());
+    }
+
+    QVERIFY(cache.find(tag, 3, QSize(113, 158)).isNull());
+    QVERIFY(cache.find(tag, 4, QSize(100, 140)).isNull());
+    QVERIFY(cache.find(QStringLiteral("other"), 3, QSize(100, 140)).isNull());
+
+    cache.clear();
+    QVERIFY(cache.find(tag, 3, QSize(100, 140)).isNull());
+}
@@ -0,0 +1,29 @@
+#include "include/slot_index_set_tests.hpp"
+#include "helpers/slot_index_set.hpp"
+
+#include <QtTest/QtTest>
+
+void slot_index_set_tests::tracks_members() {
+    slot_index_set members;
+    members.resize(130);
+    for (int index : { 3, 64, 65, 129 }) {
+        members.insert(index);
+    }
+    members.insert(64);
+    QCOMPARE(members.size(), 4);
+    QCOMPARE(members.next_from(0), 3);
+    QCOMPARE(members.next_from(4), 64);
+    QCOMPARE(members.next_from(66), 129);
+
+    members.erase(3);
+    members.erase(129);
+    QVERIFY(!members.contains(3));
+    QCOMPARE(members.size(), 2);
+    QCOMPARE(members.next_from(66), 64);
+    QVERIFY(members.at(0) == 64 || members.at(1) == 64);
+    QVERIFY(members.at(0) == 65 || members.at(1) == 65);
+
+    members.clear();
+    QVERIFY(members.empty());
+    QCOMPARE(members.next_from(0), -1);
+}
@@ -0,0 +1,62 @@
+#include "include/stall_watchdog_tests.hpp"
+#include "helpers/stall_watchdog.hpp"
+#include "helpers/trace_recorder.hpp"
+
+#include <QElapsedTimer>
+#include <QScopeGuard>
+#include <QThread>
+#include <QtTest/QtTest>
+
+#include <string>
+
+namespace {
+constexpr std::int64_t kThresholdMs = 50;
+constexpr const char* kZone = "stall_watchdog_tests_block";
+
+stall_zone_count zone_count(const stall_watchdog& watchdog) {
+    for (const stall_zone_count& count : watchdog.stalls_by_zone()) {
+        if (count.zone == kZone) {
+            return count;
+        }
+    }
+    return { kZone, 0, 0 };
+}
+} // namespace
+
+void stall_watchdog_tests::blames_stall_on_active_zone() {
+    trace_recorder& recorder = trace_recorder::instance();
+    stall_watchdog& watchdog = stall_watchdog::instance();
+    recorder.track_zones();
+    watchdog.start(kThresholdMs);
+    const auto stop_watchdog = qScopeGuard([&watchdog]() { watchdog.stop(); });
+    QVERIFY(watchdog.is_running());
+    QCOMPARE(watchdog.threshold_ms(), kThresholdMs);
+
+    const int stalls_before = watchdog.stall_count();
+    const std::int64_t counter_before
+        = recorder.counter(trace_counter::event_loop_stalls);
+    {
+        const trace_zone zone(kZone, "test");
+        QCOMPARE(recorder.active_zone(), kZone);
+        QThread::msleep(4 * kThresholdMs);
+    }
+    QVERIFY(recorder.active_zone() != kZone);
+
+    // The stall is counted once heartbeats resume; keep them well inside
+    // the threshold so waiting does not look like another stall.
+    QElapsedTimer waited;
+    waited.start();
+    while (zone_count(watchdog).stalls == 0 && waited.elapsed() < 2000) {
+        watchdog.heartbeat();
+        QThread::msleep(2);
+    }
+
+    const stall_zone_count blamed = zone_count(watchdog);
+    QCOMPARE(blamed.stalls, 1);
+    QVERIFY(blamed.worst_ms >= kThresholdMs);
+    QVERIFY(watchdog.stall_count() >= stalls_before + 1);
+    QVERIFY(
+        recorder.counter(trace_counter::event_loop_stalls)
+        >= counter_before + 1
+    );
+}
@@ -0,0 +1,135 @@
+#include "include/startup_bootstrap_tests.hpp"
+#include "helpers/startup_bootstrap.hpp"
+
+#include <QSignalSpy>
+#include <QThread>
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <functional>
+
+void startup_bootstrap_tests::gui_stages_run_queued() {
+    startup_bootstrap bootstrap;
+    QThread* stage_thread = nullptr;
+    bootstrap.add_stage(
+        QStringLiteral("window"), {}, startup_bootstrap::stage_thread::gui,
+        [&stage_thread]() { stage_thread = QThread::currentThread(); }
+    );
+    bootstrap.start();
+    QVERIFY(stage_thread == nullptr);
+
+    QTRY_VERIFY(bootstrap.is_finished());
+    QCOMPARE(stage_thread, QThread::currentThread());
+}
+
+void startup_bootstrap_tests::pool_stages_run_off_thread() {
+    startup_bootstrap bootstrap;
+    std::atomic<QThread*> stage_thread { nullptr };
+    bootstrap.add_stage(
+        QStringLiteral("strategies"), {},
+        startup_bootstrap::stage_thread::pool,
+        [&stage_thread]() { stage_thread = QThread::currentThread(); }
+    );
+    bootstrap.start();
+
+    QTRY_VERIFY(bootstrap.is_finished());
+    QVERIFY(stage_thread.load() != nullptr);
+    QVERIFY(stage_thread.load() != QThread::currentThread());
+}
+
+void startup_bootstrap_tests::stages_wait_for_all_dependencies() {
+    startup_bootstrap bootstrap;
+    std::atomic<bool> slow_done { false };
+    std::atomic<bool> fast_done { false };
+    bool saw_both = false;
+    bootstrap.add_stage(
+        QStringLiteral("slow"), {}, startup_bootstrap::stage_thread::pool,
+        [&slow_done]() {
+            QThread::msleep(30);
+            slow_done = true;
+        }
+    );
+    bootstrap.add_stage(
+        QStringLiteral("fast"), {}, startup_bootstrap::stage_thread::gui,
+        [&fast_done]() { fast_done = true; }
+    );
+    bootstrap.add_stage(
+        QStringLiteral("joined"),
+        { QStringLiteral("slow"), QStringLiteral("fast") },
+        startup_bootstrap::stage_thread::gui,
+        [&slow_done, &fast_done, &saw_both]() {
+            saw_both = slow_done && fast_done;
+        }
+    );
+    bootstrap.start();
+
+    QTRY_VERIFY(bootstrap.is_finished());
+    QVERIFY(saw_both);
+    const QVector<startup_bootstrap::stage_timing>& timings
+        = bootstrap.timings();
+    QCOMPARE(timings.size(), 3);
+    QCOMPARE(timings.last().name, QStringLiteral("joined"));
+    for (int index = 0; index < 2; ++index) {
+        QVERIFY(timings.last().ready_ms >= timings.at(index).finish_ms);
+    }
+}
+
+void startup_bootstrap_tests::deferred_stage_waits_for_done() {
+    startup_bootstrap bootstrap;
+    std::function<void()> finish_raster;
+    bool dependent_ran = false;
+    bootstrap.add_deferred_stage(
+        QStringLiteral("raster"), {},
+        [&finish_raster](std::function<void()> done) {
+            finish_raster = std::move(done);
+        }
+    );
+    bootstrap.add_stage(
+        QStringLiteral("playable"), { QStringLiteral("raster") },
+        startup_bootstrap::stage_thread::gui,
+        [&dependent_ran]() { dependent_ran = true; }
+    );
+    bootstrap.start();
+
+    QTRY_VERIFY(finish_raster != nullptr);
+    QTest::qWait(20);
+    QVERIFY(!bootstrap.is_finished());
+    QVERIFY(!dependent_ran);
+    QVERIFY(bootstrap.timings().isEmpty());
+
+    finish_raster();
+    QTRY_VERIFY(bootstrap.is_finished());
+    QVERIFY(dependent_ran);
+}
+
+void startup_bootstrap_tests::finished_fires_once() {
+    startup_bootstrap bootstrap;
+    QSignalSpy finished(&bootstrap, &startup_bootstrap::finished);
+    std::function<void()> finish_stage;
+    bootstrap.add_deferred_stage(
+        QStringLiteral("deferred"), {},
+        [&finish_stage](std::function<void()> done) {
+            finish_stage = std::move(done);
+        }
+    );
+    bootstrap.add_stage(
+        QStringLiteral("pool"), {}, startup_bootstrap::stage_thread::pool,
+        nullptr
+    );
+    bootstrap.start();
+    bootstrap.start();
+
+    QTRY_VERIFY(finish_stage != nullptr);
+    finish_stage();
+    finish_stage();
+    QTRY_VERIFY(bootstrap.is_finished());
+    const qint64 playable_ms = bootstrap.playable_ms();
+
+    bootstrap.add_stage(
+        QStringLiteral("late"), {}, startup_bootstrap::stage_thread::gui,
+        nullptr
+    );
+    QTRY_COMPARE(bootstrap.timings().size(), 3);
+    QCOMPARE(finished.count(), 1);
+    QCOMPARE(bootstrap.playable_ms(), playable_ms);
+}
@@ -0,0 +1,48 @@
+#include "include/strategy_data_tests.hpp"
+#include "helpers/strategy_data.hpp"
+
+#include <QFile>
+#include <QtTest/QtTest>
+
+void strategy_data_tests::bundled_table_matches_json() {
+    QFile file(QStringLiteral("assets/strategies.json"));
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    const std::shared_ptr<const strategy_registry> parsed
+        = strategy_registry::from_json(file.readAll());
+    const std::shared_ptr<const strategy_registry> bundled
+        = strategy_registry::with_user_strategies(QByteArray());
+
+    const QVector<strategy_data>& expected = parsed->strategies();
+    const QVector<strategy_data>& actual = bundled->strategies();
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(actual.size(), expected.size());
+    for (qsizetype index = 0; index < expected.size(); ++index) {
+        const strategy_data& want = expected.at(index);
+        const strategy_data& got = actual.at(index);
+        QCOMPARE(got.id, want.id);
+        QCOMPARE(got.slug, want.slug);
+        QCOMPARE(got.name, want.name);
+        QCOMPARE(got.date, want.date);
+        QCOMPARE(got.description, want.description);
+        QCOMPARE(got.authors, want.authors);
+        QCOMPARE(got.games, want.games);
+        QCOMPARE(got.weights, want.weights);
+        QCOMPARE(got.metrics, want.metrics);
+        QCOMPARE(got.unique_fields, want.unique_fields);
+        QCOMPARE(got.references.size(), want.references.size());
+        for (qsizetype ref = 0; ref < want.references.size(); ++ref) {
+            QCOMPARE(got.references.at(ref).type, want.references.at(ref).type);
+            QCOMPARE(
+                got.references.at(ref).citation,
+                want.references.at(ref).citation
+            );
+            QCOMPARE(got.references.at(ref).url, want.references.at(ref).url);
+            QCOMPARE(
+                got.references.at(ref).accessed,
+                want.references.at(ref).accessed
+            );
+        }
+        QVERIFY(got == want);
+    }
+    QCOMPARE(bundled->key_descriptions(), parsed->key_descriptions());
+}
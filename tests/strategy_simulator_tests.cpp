@@ -0,0 +1,23 @@
+#include "include/strategy_simulator_tests.hpp"
+#include "helpers/strategy_simulator.hpp"
+
+#include <QtTest/QtTest>
+
+#include <cmath>
+
+void strategy_simulator_tests::matches_published_hi_lo() {
+    simulation_settings settings;
+    settings.rounds = 200000;
+    settings.threads = 2;
+    settings.seed = 11;
+    strategy_simulator simulator(settings);
+
+    const QVector<int> hi_lo = { -1, 1, 1, 1, 1, 1, 0, 0, 0, -1, -1, -1, -1 };
+    const strategy_metrics metrics = simulator.run(hi_lo);
+    QVERIFY(!metrics.cancelled);
+    QCOMPARE(metrics.rounds, settings.rounds);
+    QCOMPARE(simulator.completed_rounds(), simulator.total_rounds());
+    QVERIFY(std::abs(metrics.betting_correlation - 0.97) < 0.03);
+    QVERIFY(std::abs(metrics.insurance_correlation - 0.76) < 0.03);
+    QVERIFY(metrics.playing_efficiency > 0.3);
+}
@@ -0,0 +1,31 @@
+#include "include/table_model_tests.hpp"
+#include "model/table_model.hpp"
+
+#include <QtTest/QtTest>
+
+void table_model_tests::plays_headless() {
+    table_model model;
+    model.set_slot_count(3);
+    model.set_dealing_mode(table_model::dealing_mode::random);
+    const QVector<int> hi_lo = { -1, 1, 1, 1, 1, 1, 0, 0, 0, -1, -1, -1, -1 };
+    for (int index = 0; index < model.slot_count(); ++index) {
+        model.slot(index).set_weights(hi_lo);
+    }
+    model.start_slots(7, 52, 2, false);
+
+    int deals = 0;
+    while (!model.is_game_over() && deals < 1000) {
+        for (int index = 0; index < model.slot_count(); ++index) {
+            slot_model& slot_state = model.slot(index);
+            if (slot_state.is_prompt_active()) {
+                slot_state.submit_answer(slot_state.running_count());
+                model.refresh_slot(index);
+            }
+        }
+        deals += static_cast<int>(model.deal_next().size());
+    }
+    QVERIFY(model.is_game_over());
+    QCOMPARE(deals, 3 * 2 * 52);
+    QCOMPARE(model.total_score().correct, 9);
+    QCOMPARE(model.total_score().total, 9);
+}
@@ -4,11 +4,22 @@
 #include "helpers/theme_settings.hpp"
 #include "widget/table_slot.hpp"
 
+#include "helpers/base_clock.hpp"
+#include "helpers/session_log.hpp"
+#include "helpers/session_replay.hpp"
 #include "helpers/str_label.hpp"
+#include "helpers/strategy_data.hpp"
+#include "helpers/strategy_watcher.hpp"
+#include "helpers/time_source.hpp"
 #include "widget/card_widget.hpp"
+#include "widget/table.hpp"
 
 #include <QFrame>
+#include <QFile>
 #include <QLabel>
+#include <QScopeGuard>
+#include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QtTest/QtTest>
 
 void table_tests::overlay_palette_applies_to_bars() {
@@ -256,3 +267,152 @@ void table_tests::quiz_spin_box_remembers_last_input() {
     QVERIFY(slot.is_quiz_prompt_active());
     QCOMPARE(spin_box->value(), 7);
 }
+
+void table_tests::recorded_session_replays_headless() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString path = directory.filePath(QStringLiteral("session.kcsr"));
+
+    const std::shared_ptr<time_source> previous_source
+        = time_source::instance();
+    const auto virtual_time = std::make_shared<virtual_time_source>();
+    time_source::set_instance(virtual_time);
+    const auto restore_source = qScopeGuard([&previous_source]() {
+        time_source::set_instance(previous_source);
+    });
+
+    table table_widget;
+    BaseClock game_clock;
+    QObject::connect(
+        &game_clock, &BaseClock::ticked, &table_widget, &table::on_clock_tick
+    );
+    table_widget.set_session_recorder(
+        std::make_shared<session_recorder>(path.toStdString())
+    );
+    table_widget.set_slot_count(3);
+    table_widget.set_dealing_mode(1);
+    table_widget.set_pick_interval(50);
+    table_widget.start_quiz(0, false);
+    game_clock.start();
+    virtual_time->advance_ms(20000);
+    QCOMPARE(game_clock.elapsed_time_ms(), qint64 { 20000 });
+    table_widget.clear_quiz();
+
+    session_log log;
+    QVERIFY(log.read_from(path.toStdString()));
+    QCOMPARE(log.header.seed, table_widget.session_seed());
+    QCOMPARE(static_cast<int>(log.slot_setups.size()), 3);
+
+    const session_replay_result result = session_replay(log).run();
+    QVERIFY(result.picks > 0);
+    QCOMPARE(result.mismatched_picks, 0);
+    QCOMPARE(result.mismatched_answers, 0);
+}
+
+void table_tests::recorded_sessions_append_and_flush_on_close() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString path = directory.filePath(QStringLiteral("sessions.kcsr"));
+
+    const std::shared_ptr<time_source> previous_source
+        = time_source::instance();
+    const auto virtual_time = std::make_shared<virtual_time_source>();
+    time_source::set_instance(virtual_time);
+    const auto restore_source = qScopeGuard([&previous_source]() {
+        time_source::set_instance(previous_source);
+    });
+
+    std::uint64_t first_seed = 0;
+    {
+        table table_widget;
+        BaseClock game_clock;
+        QObject::connect(
+            &game_clock, &BaseClock::ticked, &table_widget,
+            &table::on_clock_tick
+        );
+        table_widget.set_session_recorder(
+            std::make_shared<session_recorder>(path.toStdString())
+        );
+        table_widget.set_slot_count(2);
+        table_widget.set_pick_interval(50);
+        table_widget.start_quiz(0, false);
+        first_seed = table_widget.session_seed();
+        game_clock.start();
+        virtual_time->advance_ms(5000);
+        table_widget.clear_quiz();
+
+        game_clock.reset();
+        table_widget.start_quiz(0, false);
+        game_clock.start();
+        virtual_time->advance_ms(5000);
+        // The second session is still running when the table goes away.
+    }
+
+    session_log log;
+    QVERIFY(log.read_from(path.toStdString()));
+    QCOMPARE(log.sessions_count, 2);
+    QVERIFY(log.header.seed != first_seed);
+    QVERIFY(!log.events.empty());
+    QVERIFY(log.events.back().kind == session_event_kind::game_over);
+
+    QVERIFY(log.read_from(path.toStdString(), 0));
+    QCOMPARE(log.header.seed, first_seed);
+    QCOMPARE(session_replay(log).run().mismatched_picks, 0);
+    QVERIFY(!log.read_from(path.toStdString(), 2));
+}
+
+void table_tests::user_strategy_edits_reload_live() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString path = directory.filePath(QStringLiteral("strategies.json"));
+    auto write_strategy = [&path](const QByteArray& weights) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(
+            "{\"strategies\": [{\"id\": 9001, \"slug\": \"test_count\", "
+            "\"name\": \"Test Count\", \"weights\": ["
+            + weights + "]}]}"
+        );
+    };
+
+    const std::shared_ptr<const strategy_registry> previous_registry
+        = strategy_registry::instance();
+    const auto restore_registry = qScopeGuard([&previous_registry]() {
+        strategy_registry::set_instance(previous_registry);
+    });
+    strategy_watcher watcher(path);
+    QSignalSpy changes(&watcher, &strategy_watcher::strategies_changed);
+    write_strategy("1,1,1,1,1,1,1,1,1,1,1,1,1");
+    watcher.reload();
+    QCOMPARE(changes.count(), 1);
+    QCOMPARE(
+        changes.takeFirst().at(0).toStringList(),
+        QStringList { QStringLiteral("Test Count") }
+    );
+
+    table table_widget;
+    table_widget.set_slot_count(2);
+    table_widget.apply_strategy_changes({ QStringLiteral("Test Count") });
+    auto slot_widgets = table_widget.findChildren<table_slot*>();
+    QCOMPARE(slot_widgets.size(), 2);
+    auto combo_boxes = slot_widgets.at(0)->findChildren<BaseComboBox*>();
+    QVERIFY(!combo_boxes.isEmpty());
+    combo_boxes.first()->setCurrentText(QStringLiteral("Test Count"));
+    QCOMPARE(slot_widgets.at(0)->strategy_name(), QStringLiteral("Test Count"));
+
+    auto weights_of = [](table_slot* slot) {
+        return slot->findChild<card_widget*>()->strategy_weight_values();
+    };
+    const QVector<int> untouched = weights_of(slot_widgets.at(1));
+    write_strategy("2,2,2,2,2,2,2,2,2,2,2,2,2");
+    watcher.reload();
+    QCOMPARE(changes.count(), 1);
+    table_widget.apply_strategy_changes(
+        changes.takeFirst().at(0).toStringList()
+    );
+    QCOMPARE(weights_of(slot_widgets.at(0)), QVector<int>(13, 2));
+    QCOMPARE(weights_of(slot_widgets.at(1)), untouched);
+
+    watcher.reload();
+    QCOMPARE(changes.count(), 0);
+}
@@ -0,0 +1,143 @@
+#include "include/trace_recorder_tests.hpp"
+#include "helpers/trace_recorder.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QScopeGuard>
+#include <QThread>
+#include <QtTest/QtTest>
+
+namespace {
+QJsonObject find_event(const QJsonArray& events, const QString& name) {
+    for (const QJsonValue& value : events) {
+        const QJsonObject event = value.toObject();
+        if (event.value(QStringLiteral("name")).toString() == name) {
+            return event;
+        }
+    }
+    return QJsonObject();
+}
+
+qint64 field(const QJsonObject& event, const char* key) {
+    return event.value(QLatin1String(key)).toInteger();
+}
+
+// Raster jobs left over from earlier suites may still record from the pool.
+QVector<QJsonObject> find_counter_events(
+    const QJsonArray& events, const QString& name, qint64 thread
+) {
+    QVector<QJsonObject> found;
+    for (const QJsonValue& value : events) {
+        const QJsonObject event = value.toObject();
+        if (event.value(QStringLiteral("ph")).toString() == QStringLiteral("C")
+            && event.value(QStringLiteral("name")).toString() == name
+            && field(event, "tid") == thread) {
+            found.append(event);
+        }
+    }
+    return found;
+}
+} // namespace
+
+void trace_recorder_tests::disabled_records_nothing() {
+    trace_recorder& recorder = trace_recorder::instance();
+    recorder.disable();
+    recorder.clear();
+
+    {
+        const trace_zone zone("disabled_zone", "test");
+        recorder.add_instant("disabled_instant", "test");
+        recorder.add_to_counter(trace_counter::raster_jobs_pending, 1);
+        recorder.add_to_counter(trace_counter::raster_jobs_pending, -1);
+    }
+    QCOMPARE(recorder.event_count(), std::size_t { 0 });
+}
+
+void trace_recorder_tests::zones_and_counters_export_as_json() {
+    trace_recorder& recorder = trace_recorder::instance();
+    recorder.clear();
+    recorder.enable();
+    const auto reset_recorder = qScopeGuard([&recorder]() {
+        recorder.disable();
+        recorder.clear();
+    });
+
+    {
+        const trace_zone outer("outer_zone", "test");
+        {
+            const trace_zone inner("inner_zone", "test");
+            QThread::msleep(2);
+        }
+        recorder.add_to_counter(trace_counter::raster_jobs_pending, 3);
+        recorder.add_to_counter(trace_counter::raster_jobs_pending, -3);
+    }
+    recorder.disable();
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(
+        QByteArray::fromStdString(recorder.to_json()), &error
+    );
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    const QJsonArray events
+        = document.object().value(QStringLiteral("traceEvents")).toArray();
+
+    const QJsonObject outer = find_event(events, QStringLiteral("outer_zone"));
+    const QJsonObject inner = find_event(events, QStringLiteral("inner_zone"));
+    QCOMPARE(outer.value(QStringLiteral("ph")).toString(), QStringLiteral("X"));
+    QCOMPARE(inner.value(QStringLiteral("ph")).toString(), QStringLiteral("X"));
+    QCOMPARE(
+        inner.value(QStringLiteral("cat")).toString(), QStringLiteral("test")
+    );
+    QCOMPARE(field(inner, "tid"), field(outer, "tid"));
+    QVERIFY(field(inner, "dur") >= 2000);
+    QVERIFY(field(inner, "ts") >= field(outer, "ts"));
+    QVERIFY(
+        field(inner, "ts") + field(inner, "dur")
+        <= field(outer, "ts") + field(outer, "dur")
+    );
+
+    const QVector<QJsonObject> counters = find_counter_events(
+        events, QStringLiteral("raster_jobs_pending"), field(outer, "tid")
+    );
+    QCOMPARE(counters.size(), 2);
+    const auto counter_value = [](const QJsonObject& event) {
+        return event.value(QStringLiteral("args"))
+            .toObject()
+            .value(QStringLiteral("value"))
+            .toInteger();
+    };
+    QCOMPARE(
+        counter_value(counters.at(0)) - counter_value(counters.at(1)),
+        qint64 { 3 }
+    );
+    QVERIFY(field(counters.at(0), "ts") <= field(counters.at(1), "ts"));
+    QVERIFY(field(counters.at(0), "ts") >= field(inner, "ts"));
+    QVERIFY(
+        recorder.counter_peak(trace_counter::raster_jobs_pending)
+        >= counter_value(counters.at(0))
+    );
+}
+
+void trace_recorder_tests::event_buffer_is_capped() {
+    trace_recorder& recorder = trace_recorder::instance();
+    recorder.clear();
+    recorder.enable();
+    const auto reset_recorder = qScopeGuard([&recorder]() {
+        recorder.disable();
+        recorder.clear();
+    });
+
+    for (std::size_t index = 0; index < trace_recorder::max_events + 16;
+         ++index) {
+        recorder.add_complete(
+            "filler", "test", static_cast<std::int64_t>(index), 1
+        );
+    }
+    QCOMPARE(recorder.event_count(), trace_recorder::max_events);
+    recorder.add_instant("dropped", "test");
+    QCOMPARE(recorder.event_count(), trace_recorder::max_events);
+
+    recorder.clear();
+    QCOMPARE(recorder.event_count(), std::size_t { 0 });
+}